@@ -0,0 +1,32 @@
+//
+//  MmkvArguments.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+/**
+ Range checks for numbers that are passed from JS.
+
+ JS numbers are doubles, so they have to be checked before they are cast to an integer type -
+ casting NaN, Infinity or a value outside of the target type's range is undefined behaviour.
+ */
+namespace MmkvArguments {
+
+// The largest integer that a double (and therefore a JS number) represents exactly (2^53 - 1).
+inline constexpr double kMaxSafeInteger = 9007199254740991.0;
+inline constexpr double kMaxInt32 = static_cast<double>(std::numeric_limits<int32_t>::max());
+
+/**
+ Returns whether `value` is an integer in [min, max].
+ `false` for NaN, Infinity and fractions.
+ */
+inline bool isIntegerInRange(double value, double min, double max) {
+  return std::isfinite(value) && value >= min && value <= max && std::trunc(value) == value;
+}
+
+} // namespace MmkvArguments
@@ -0,0 +1,69 @@
+//
+//  MmkvBackgroundQueue.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvBackgroundQueue.h"
+#include "MmkvLogger.h"
+#include <exception>
+
+MmkvBackgroundQueue& MmkvBackgroundQueue::shared() {
+  // Intentionally leaked so tasks can still run while static destructors are running.
+  static MmkvBackgroundQueue* queue = new MmkvBackgroundQueue();
+  return *queue;
+}
+
+MmkvBackgroundQueue::MmkvBackgroundQueue() {
+  _thread = std::thread([this]() { run(); });
+  _thread.detach();
+}
+
+void MmkvBackgroundQueue::dispatch(std::function<void()>&& task) {
+  {
+    std::unique_lock lock(_mutex);
+    _tasks.push_back(std::move(task));
+  }
+  _condition.notify_one();
+}
+
+void MmkvBackgroundQueue::dispatchAfter(std::chrono::steady_clock::duration delay,
+                                        std::function<void()>&& task) {
+  {
+    std::unique_lock lock(_mutex);
+    _delayedTasks.emplace(std::chrono::steady_clock::now() + delay, std::move(task));
+  }
+  _condition.notify_one();
+}
+
+void MmkvBackgroundQueue::run() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock lock(_mutex);
+      while (true) {
+        // Delayed tasks that are due run after the tasks that have already been dispatched.
+        auto now = std::chrono::steady_clock::now();
+        while (!_delayedTasks.empty() && _delayedTasks.begin()->first <= now) {
+          _tasks.push_back(std::move(_delayedTasks.begin()->second));
+          _delayedTasks.erase(_delayedTasks.begin());
+        }
+        if (!_tasks.empty()) {
+          break;
+        }
+        if (_delayedTasks.empty()) {
+          _condition.wait(lock);
+        } else {
+          _condition.wait_until(lock, _delayedTasks.begin()->first);
+        }
+      }
+      task = std::move(_tasks.front());
+      _tasks.pop_front();
+    }
+
+    try {
+      task();
+    } catch (const std::exception& exception) {
+      MmkvLogger::log("RNMMKV", "Background task failed: %s", exception.what());
+    }
+  }
+}
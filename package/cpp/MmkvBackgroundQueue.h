@@ -0,0 +1,47 @@
+//
+//  MmkvBackgroundQueue.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+/**
+ A serial queue that runs tasks on a single background thread, in order.
+ Used for work that should not block the JS thread (prefetching, flushing, ...).
+ */
+class MmkvBackgroundQueue {
+public:
+  /**
+   Get the shared background queue. It lives for the whole lifetime of the process.
+   */
+  static MmkvBackgroundQueue& shared();
+
+  /**
+   Schedules the given task to run on the background thread.
+   */
+  void dispatch(std::function<void()>&& task);
+
+  /**
+   Schedules the given task to run on the background thread once the given delay has passed.
+   */
+  void dispatchAfter(std::chrono::steady_clock::duration delay, std::function<void()>&& task);
+
+private:
+  MmkvBackgroundQueue();
+  void run();
+
+private:
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  std::deque<std::function<void()>> _tasks;
+  std::multimap<std::chrono::steady_clock::time_point, std::function<void()>> _delayedTasks;
+  std::thread _thread;
+};
@@ -0,0 +1,124 @@
+//
+//  MmkvChangeLog.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvChangeLog.h"
+#include "MmkvLogger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+MmkvChangeLog::PendingChange::PendingChange(PendingChange&& other) noexcept
+    : _log(std::exchange(other._log, nullptr)), _sequence(other._sequence) {}
+
+MmkvChangeLog::PendingChange::~PendingChange() {
+  if (_log != nullptr) {
+    _log->finish(_sequence);
+  }
+}
+
+MmkvChangeLog::MmkvChangeLog(MMKV* storage) : _storage(storage), _sequence(0) {
+  for (std::string& key : _storage->allKeys()) {
+    int64_t value = _storage->getInt64(key);
+    if (value == 0) [[unlikely]] {
+      continue;
+    }
+    int64_t sequence = std::abs(value);
+    _sequence = std::max(_sequence, sequence);
+    _changes.emplace(sequence, Entry{std::move(key), value < 0});
+  }
+  MmkvLogger::log("RNMMKV", "Loaded change log \"%s\" (%zu keys, sequence %lld)",
+                  _storage->mmapID().c_str(), _changes.size(), static_cast<long long>(_sequence));
+}
+
+int64_t MmkvChangeLog::record(const std::string& key, bool isDeleted) {
+  int64_t previous = _storage->getInt64(key);
+  if (previous != 0) {
+    _changes.erase(std::abs(previous));
+  }
+  int64_t sequence = ++_sequence;
+  _storage->set(isDeleted ? -sequence : sequence, key);
+  _changes.emplace_hint(_changes.end(), sequence, Entry{key, isDeleted});
+  return sequence;
+}
+
+MmkvChangeLog::PendingChange MmkvChangeLog::recordWrite(const std::string& key) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  int64_t sequence = record(key, false);
+  _pending.insert(sequence);
+  return PendingChange(this, sequence);
+}
+
+MmkvChangeLog::PendingChange MmkvChangeLog::recordDelete(const std::string& key) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  int64_t sequence = record(key, true);
+  _pending.insert(sequence);
+  return PendingChange(this, sequence);
+}
+
+MmkvChangeLog::PendingChange MmkvChangeLog::recordDeletes(const std::vector<std::string>& keys) {
+  if (keys.empty()) {
+    return PendingChange();
+  }
+  std::lock_guard<std::mutex> lock(_mutex);
+  int64_t first = _sequence + 1;
+  for (const std::string& key : keys) {
+    record(key, true);
+  }
+  _pending.insert(first);
+  return PendingChange(this, first);
+}
+
+void MmkvChangeLog::finish(int64_t sequence) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _pending.erase(sequence);
+}
+
+int64_t MmkvChangeLog::getVisibleSequence() const {
+  return _pending.empty() ? _sequence : *_pending.begin() - 1;
+}
+
+std::vector<MmkvChangeLog::Change> MmkvChangeLog::getChangesSince(int64_t sequence, size_t limit,
+                                                                  int64_t& nextSequence,
+                                                                  bool& hasMore) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  // Changes that are still being made are left for the next call, so none of them can be skipped.
+  int64_t latest = getVisibleSequence();
+  std::vector<Change> changes;
+  auto it = _changes.upper_bound(sequence);
+  for (; it != _changes.end() && it->first <= latest && changes.size() < limit; ++it) {
+    changes.push_back({it->second.key, it->first, it->second.isDeleted});
+  }
+  hasMore = it != _changes.end() && it->first <= latest;
+  nextSequence = hasMore ? changes.back().sequence : std::max(sequence, latest);
+  return changes;
+}
+
+int64_t MmkvChangeLog::getSequence() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return getVisibleSequence();
+}
+
+size_t MmkvChangeLog::truncateBefore(int64_t sequence) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  // Changes that are still being made have not been seen by anyone yet.
+  auto end = _changes.upper_bound(std::min(sequence, getVisibleSequence()));
+  if (end == _changes.end() && end != _changes.begin()) {
+    --end;
+  }
+  std::vector<std::string> keys;
+  for (auto it = _changes.begin(); it != end; ++it) {
+    keys.push_back(it->second.key);
+  }
+  if (keys.empty()) {
+    return 0;
+  }
+  _storage->removeValuesForKeys(keys);
+  _changes.erase(_changes.begin(), end);
+  return keys.size();
+}
+
+void MmkvChangeLog::trim() {
+  _storage->trim();
+}
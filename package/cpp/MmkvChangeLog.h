@@ -0,0 +1,105 @@
+//
+//  MmkvChangeLog.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKV.h"
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ A persistent log of which keys of an instance changed, stored in its own MMKV instance (the
+ `changeLog` config option).
+
+ Every write and delete gets the next sequence number, and the log stores each key's latest one
+ (negated for deletes). So the log holds one small record per key that was ever written, no matter
+ how often it changed - deleted keys keep theirs, so readers that are behind still see the delete.
+ The log only shrinks when it is truncated (see `truncateBefore`). The latest sequence number is
+ not stored separately - it is the largest one in the log.
+
+ A change is logged before it is made: a crash in between leaves a change in the log that was not
+ made (readers just read the unchanged value), instead of a change that is missing from the log.
+ Readers only see the changes before the first one that is still being made.
+
+ When the log is opened, its keys are indexed by sequence number in memory, so a page of changes
+ costs O(limit) instead of a pass over all keys. That index only lives in this process, so the log
+ can't be used in MULTI_PROCESS mode.
+ */
+class MmkvChangeLog {
+public:
+  struct Change {
+    std::string key;
+    int64_t sequence;
+    bool isDeleted;
+  };
+
+  /**
+   A change that was logged, but not made yet. Readers see it once this is destroyed.
+   */
+  class PendingChange {
+  public:
+    PendingChange() = default;
+    PendingChange(PendingChange&& other) noexcept;
+    PendingChange& operator=(PendingChange&&) = delete;
+    ~PendingChange();
+
+  private:
+    friend class MmkvChangeLog;
+    PendingChange(MmkvChangeLog* log, int64_t sequence) : _log(log), _sequence(sequence) {}
+
+  private:
+    MmkvChangeLog* _log = nullptr;
+    int64_t _sequence = 0;
+  };
+
+  explicit MmkvChangeLog(MMKV* storage);
+
+  [[nodiscard]] PendingChange recordWrite(const std::string& key);
+  [[nodiscard]] PendingChange recordDelete(const std::string& key);
+  [[nodiscard]] PendingChange recordDeletes(const std::vector<std::string>& keys);
+
+  /**
+   Returns at most `limit` (at least 1) changes with a sequence number larger than `sequence`,
+   oldest first. `nextSequence` is set to the sequence number to continue from, and `hasMore` if
+   there already are more changes after it.
+   */
+  std::vector<Change> getChangesSince(int64_t sequence, size_t limit, int64_t& nextSequence,
+                                      bool& hasMore);
+  /**
+   The latest sequence number readers can see.
+   */
+  int64_t getSequence();
+  /**
+   Removes the changes up to and including `sequence` (the ones a reader that got to `sequence` has
+   seen), except the latest one, which the sequence number is restored from. Returns how many were
+   removed. Readers that are behind `sequence` miss those changes, so they have to start over.
+   */
+  size_t truncateBefore(int64_t sequence);
+  void trim();
+
+private:
+  struct Entry {
+    std::string key;
+    bool isDeleted;
+  };
+
+  // All of these expect `_mutex` to be held.
+  int64_t record(const std::string& key, bool isDeleted);
+  int64_t getVisibleSequence() const;
+  void finish(int64_t sequence);
+
+private:
+  MMKV* _storage;
+  std::mutex _mutex;
+  int64_t _sequence;
+  // Every key's latest change, by sequence number.
+  std::map<int64_t, Entry> _changes;
+  // The first sequence numbers of changes that are logged, but not made yet.
+  std::set<int64_t> _pending;
+};
@@ -0,0 +1,32 @@
+//
+//  MmkvDiff.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvDiff.h"
+#include "MmkvRawValue.h"
+#include <algorithm>
+
+MmkvDiff::Result MmkvDiff::compute(const Side& from, const Side& to) {
+  Result result;
+
+  for (const auto& [key, storedKey] : from.keys) {
+    auto other = to.keys.find(key);
+    if (other == to.keys.end()) {
+      result.removed.push_back(key);
+    } else if (!MmkvRawValue::equals(from.getInstance(storedKey), storedKey,
+                                     to.getInstance(other->second), other->second)) {
+      result.changed.push_back(key);
+    }
+  }
+  for (const auto& [key, storedKey] : to.keys) {
+    if (from.keys.count(key) == 0) {
+      result.added.push_back(key);
+    }
+  }
+
+  std::sort(result.added.begin(), result.added.end());
+  std::sort(result.removed.begin(), result.removed.end());
+  std::sort(result.changed.begin(), result.changed.end());
+  return result;
+}
@@ -0,0 +1,42 @@
+//
+//  MmkvDiff.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKV.h"
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ Compares the keys and values of two instances natively.
+
+ Values are compared by their stored size first, and only values of the same size are read and
+ compared by their stored bytes (see MmkvRawValue) - so values that obviously changed are never
+ read.
+ */
+class MmkvDiff {
+public:
+  /**
+   One side of a diff: its keys (as seen by JS, mapped to how they are stored), and the instance
+   each stored key has to be read from (which differs for overlays).
+   */
+  struct Side {
+    std::unordered_map<std::string, std::string> keys;
+    std::function<MMKV*(const std::string& storedKey)> getInstance;
+  };
+
+  struct Result {
+    // Keys that only exist in `to`
+    std::vector<std::string> added;
+    // Keys that only exist in `from`
+    std::vector<std::string> removed;
+    // Keys that exist in both, but with different values
+    std::vector<std::string> changed;
+  };
+
+  static Result compute(const Side& from, const Side& to);
+};
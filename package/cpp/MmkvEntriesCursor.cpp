@@ -0,0 +1,121 @@
+//
+//  MmkvEntriesCursor.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvEntriesCursor.h"
+#include "MMKVManagedBuffer.h"
+#include "MmkvNumbers.h"
+#include "MmkvValueCompare.h"
+
+MmkvEntriesCursor::MmkvEntriesCursor(
+    std::function<MMKV*(const std::string& storedKey)> getReadInstance, MmkvKeyCodec keyCodec,
+    std::vector<std::string> keys, MmkvValueType type, size_t chunkSize)
+    : _getReadInstance(std::move(getReadInstance)), _keyCodec(std::move(keyCodec)),
+      _keys(std::move(keys)), _type(type), _chunkSize(chunkSize), _position(0) {}
+
+// Strings and buffers are stored as a varint length followed by exactly that many bytes.
+static bool isLengthDelimited(MMKV* instance, const std::string& key) {
+  size_t rawSize = instance->getValueSize(key, false);
+  size_t actualSize = instance->getValueSize(key, true);
+  return rawSize > 0 && rawSize == MmkvValueCompare::getVarintSize(actualSize) + actualSize;
+}
+
+std::vector<jsi::PropNameID> MmkvEntriesCursor::getPropertyNames(jsi::Runtime& rt) {
+  return jsi::PropNameID::names(rt, "next");
+}
+
+MmkvValueType MmkvEntriesCursor::parseValueType(jsi::Runtime& runtime, const std::string& type) {
+  if (type == "string") {
+    return MmkvValueType::String;
+  } else if (type == "number") {
+    return MmkvValueType::Number;
+  } else if (type == "boolean") {
+    return MmkvValueType::Boolean;
+  } else if (type == "buffer") {
+    return MmkvValueType::Buffer;
+  } else [[unlikely]] {
+    throw jsi::JSError(runtime, "Invalid value type \"" + type +
+                                    "\"! Expected \"string\", \"number\", \"boolean\" or "
+                                    "\"buffer\".");
+  }
+}
+
+jsi::Value MmkvEntriesCursor::get(jsi::Runtime& runtime, const jsi::PropNameID& propNameId) {
+  std::string propName = propNameId.utf8(runtime);
+
+  if (propName == "next") {
+    // cursor.next(): [key, value][] | undefined
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName), 0,
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value { return next(runtime); });
+  }
+
+  return jsi::Value::undefined();
+}
+
+jsi::Value MmkvEntriesCursor::next(jsi::Runtime& runtime) {
+  if (_position >= _keys.size()) {
+    return jsi::Value::undefined();
+  }
+
+  std::vector<jsi::Value> entries;
+  entries.reserve(_chunkSize);
+  // Keys that have been deleted since the cursor was created, and values that are not of the
+  // requested type are skipped, so keep going until the chunk is full or there are no keys left.
+  while (_position < _keys.size() && entries.size() < _chunkSize) {
+    const std::string& key = _keys[_position++];
+    jsi::Value value = readValue(runtime, _getReadInstance(key), key, _type);
+    if (value.isUndefined()) {
+      continue;
+    }
+    jsi::Array entry(runtime, 2);
+    entry.setValueAtIndex(runtime, 0, jsi::String::createFromUtf8(runtime, _keyCodec.decode(key)));
+    entry.setValueAtIndex(runtime, 1, std::move(value));
+    entries.push_back(std::move(entry));
+  }
+
+  jsi::Array array(runtime, entries.size());
+  for (size_t i = 0; i < entries.size(); i++) {
+    array.setValueAtIndex(runtime, i, std::move(entries[i]));
+  }
+  return array;
+}
+
+jsi::Value MmkvEntriesCursor::readValue(jsi::Runtime& runtime, MMKV* instance,
+                                        const std::string& key, MmkvValueType type) {
+  switch (type) {
+    case MmkvValueType::String: {
+      std::string result;
+      if (!isLengthDelimited(instance, key) || !instance->getString(key, result)) {
+        return jsi::Value::undefined();
+      }
+      return jsi::String::createFromUtf8(runtime, result);
+    }
+    case MmkvValueType::Number: {
+      bool hasValue;
+      double value = MmkvNumbers::get(instance, key, &hasValue);
+      return hasValue ? jsi::Value(value) : jsi::Value::undefined();
+    }
+    case MmkvValueType::Boolean: {
+      // Booleans are stored as a single-byte varint, 0 or 1.
+      if (instance->getValueSize(key, false) != 1) {
+        return jsi::Value::undefined();
+      }
+      bool hasValue;
+      int64_t value = instance->getInt64(key, 0, &hasValue);
+      return hasValue && (value == 0 || value == 1) ? jsi::Value(value == 1)
+                                                    : jsi::Value::undefined();
+    }
+    case MmkvValueType::Buffer: {
+      mmkv::MMBuffer buffer;
+      if (!isLengthDelimited(instance, key) || !instance->getBytes(key, buffer)) {
+        return jsi::Value::undefined();
+      }
+      auto mutableData = std::make_shared<MMKVManagedBuffer>(std::move(buffer));
+      return jsi::ArrayBuffer(runtime, mutableData);
+    }
+  }
+  return jsi::Value::undefined();
+}
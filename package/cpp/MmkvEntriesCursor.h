@@ -0,0 +1,57 @@
+//
+//  MmkvEntriesCursor.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKV.h"
+#include "MmkvKeyCodec.h"
+#include <functional>
+#include <jsi/jsi.h>
+#include <string>
+#include <vector>
+
+using namespace facebook;
+using namespace mmkv;
+
+/**
+ The type values are decoded as when iterating over entries.
+ MMKV does not store types, so the caller has to specify it.
+ */
+enum class MmkvValueType { String, Number, Boolean, Buffer };
+
+/**
+ A jsi::HostObject that iterates over a snapshot of an MMKV instance's keys and returns
+ [key, value] pairs in chunks, so walking all entries only crosses JSI once per chunk.
+ */
+class MmkvEntriesCursor : public jsi::HostObject {
+public:
+  /**
+   `getReadInstance` returns the instance a stored key has to be read from at the time it is read
+   (which differs for overlays, and respects keys that were deleted after the snapshot).
+   */
+  MmkvEntriesCursor(std::function<MMKV*(const std::string& storedKey)> getReadInstance,
+                    MmkvKeyCodec keyCodec, std::vector<std::string> keys, MmkvValueType type,
+                    size_t chunkSize);
+
+public:
+  jsi::Value get(jsi::Runtime&, const jsi::PropNameID& name) override;
+  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& rt) override;
+
+  static MmkvValueType parseValueType(jsi::Runtime& runtime, const std::string& type);
+
+private:
+  jsi::Value next(jsi::Runtime& runtime);
+  static jsi::Value readValue(jsi::Runtime& runtime, MMKV* instance, const std::string& key,
+                              MmkvValueType type);
+
+private:
+  std::function<MMKV*(const std::string& storedKey)> _getReadInstance;
+  // Keys are stored encoded, but returned to JS decoded.
+  MmkvKeyCodec _keyCodec;
+  std::vector<std::string> _keys;
+  MmkvValueType _type;
+  size_t _chunkSize;
+  size_t _position;
+};
@@ -0,0 +1,71 @@
+//
+//  MmkvFastBindings.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvFastBindings.h"
+#include "MmkvHostObject.h"
+
+std::mutex MmkvFastBindings::_mutex;
+std::vector<MmkvHostObject*> MmkvFastBindings::_instances;
+std::vector<size_t> MmkvFastBindings::_freeHandles;
+
+size_t MmkvFastBindings::registerInstance(MmkvHostObject* hostObject) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_freeHandles.empty()) {
+    size_t handle = _freeHandles.back();
+    _freeHandles.pop_back();
+    _instances[handle] = hostObject;
+    return handle;
+  }
+  _instances.push_back(hostObject);
+  return _instances.size() - 1;
+}
+
+void MmkvFastBindings::unregisterInstance(size_t handle) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _instances[handle] = nullptr;
+  _freeHandles.push_back(handle);
+}
+
+MmkvHostObject* MmkvFastBindings::getInstance(jsi::Runtime& runtime, const jsi::Value* arguments,
+                                              size_t count) {
+  if (count > 0 && arguments[0].isNumber()) [[likely]] {
+    double handle = arguments[0].getNumber();
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (handle >= 0 && handle < _instances.size()) [[likely]] {
+      MmkvHostObject* hostObject = _instances[static_cast<size_t>(handle)];
+      if (hostObject != nullptr && handle == static_cast<double>(static_cast<size_t>(handle)))
+          [[likely]] {
+        return hostObject;
+      }
+    }
+  }
+  throw jsi::JSError(runtime, "First argument ('handle') is not a valid MMKV instance handle!");
+}
+
+void MmkvFastBindings::install(jsi::Runtime& runtime) {
+  jsi::Object bindings(runtime);
+
+  auto bind = [&](const char* name, unsigned int paramCount,
+                  jsi::Value (MmkvHostObject::*method)(jsi::Runtime&, const jsi::Value*, size_t)) {
+    jsi::Function function = jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, name), paramCount,
+        [method](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+                 size_t count) -> jsi::Value {
+          MmkvHostObject* hostObject = getInstance(runtime, arguments, count);
+          // Everything after the handle are the method's regular arguments.
+          return (hostObject->*method)(runtime, arguments + 1, count - 1);
+        });
+    bindings.setProperty(runtime, name, std::move(function));
+  };
+
+  bind("set", 3, &MmkvHostObject::callSet);                // handle, key, value
+  bind("getBoolean", 2, &MmkvHostObject::callGetBoolean);  // handle, key
+  bind("getNumber", 2, &MmkvHostObject::callGetNumber);    // handle, key
+  bind("getString", 2, &MmkvHostObject::callGetString);    // handle, key
+  bind("contains", 2, &MmkvHostObject::callContains);      // handle, key
+  bind("delete", 2, &MmkvHostObject::callDelete);          // handle, key
+
+  runtime.global().setProperty(runtime, "__mmkv", std::move(bindings));
+}
@@ -0,0 +1,48 @@
+//
+//  MmkvFastBindings.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <jsi/jsi.h>
+#include <mutex>
+#include <vector>
+
+using namespace facebook;
+
+class MmkvHostObject;
+
+/**
+ Flat, handle-based bindings for the hottest methods, installed as `global.__mmkv`.
+
+ Every instance gets a small integer handle that indexes into a native table, so a call like
+ `__mmkv.getString(handle, key)` is a plain function call - there is no HostObject property lookup
+ (and no `jsi::Function` created or cached per property), and the engine can inline-cache the
+ function in hot loops.
+ */
+class MmkvFastBindings {
+public:
+  /**
+   Installs `global.__mmkv` into the given runtime.
+   */
+  static void install(jsi::Runtime& runtime);
+
+  /**
+   Assigns a handle to the given instance. The handle is valid until it is unregistered.
+   */
+  static size_t registerInstance(MmkvHostObject* hostObject);
+  static void unregisterInstance(size_t handle);
+
+private:
+  static MmkvHostObject* getInstance(jsi::Runtime& runtime, const jsi::Value* arguments,
+                                     size_t count);
+
+private:
+  // Instances are registered on the JS thread, but can be unregistered on any thread (if the C++
+  // API held the last reference), so every access - including lookups - holds the mutex. The
+  // instance itself stays alive while JS holds it, which it does whenever it calls with its handle.
+  static std::mutex _mutex;
+  static std::vector<MmkvHostObject*> _instances;
+  static std::vector<size_t> _freeHandles;
+};
@@ -0,0 +1,59 @@
+//
+//  MmkvFileAdvisor.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvFileAdvisor.h"
+#include <algorithm>
+#include <climits>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+void MmkvFileAdvisor::willNeed() const {
+  if (_path.empty()) {
+    return;
+  }
+  int fd = open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return;
+  }
+
+#ifdef __APPLE__
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+    struct radvisory advisory;
+    advisory.ra_offset = 0;
+    advisory.ra_count = static_cast<int>(std::min<off_t>(fileStat.st_size, INT_MAX));
+    fcntl(fd, F_RDADVISE, &advisory);
+  }
+#else
+  posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+
+  close(fd);
+}
+
+void MmkvFileAdvisor::dontNeed() const {
+#ifndef __APPLE__
+  // Darwin has no equivalent to POSIX_FADV_DONTNEED, the kernel decides on its own there.
+  if (_path.empty()) {
+    return;
+  }
+  int fd = open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return;
+  }
+  posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  close(fd);
+#endif
+}
+
+std::string MmkvFileAdvisor::getFilePath(const std::string& instanceId,
+                                         const std::string& rootPath) {
+  if (instanceId.find_first_of("\\/:*?\"<>|") != std::string::npos) {
+    // MMKV stores IDs with special characters under a hashed file name - we don't guess those.
+    return "";
+  }
+  return rootPath + "/" + instanceId;
+}
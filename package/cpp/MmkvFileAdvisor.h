@@ -0,0 +1,37 @@
+//
+//  MmkvFileAdvisor.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <string>
+
+/**
+ Gives the kernel hints about how an MMKV file is going to be accessed.
+ All hints are best-effort - if the file cannot be opened (e.g. because it does not exist yet), they
+ are no-ops.
+ */
+class MmkvFileAdvisor {
+public:
+  MmkvFileAdvisor() = default;
+  explicit MmkvFileAdvisor(std::string path) : _path(std::move(path)) {}
+
+  /**
+   Starts asynchronously reading the whole file into the page-cache, so that MMKV's sequential
+   load does not page-fault once per page.
+   */
+  void willNeed() const;
+  /**
+   Drops the (clean, unmapped) pages of the file from the page-cache.
+   */
+  void dontNeed() const;
+
+  /**
+   Get the path of the MMKV file for the given instance ID and root directory.
+   */
+  static std::string getFilePath(const std::string& instanceId, const std::string& rootPath);
+
+private:
+  std::string _path;
+};
@@ -8,34 +8,78 @@
 
 #include "MmkvHostObject.h"
 #include "MMKVManagedBuffer.h"
+#include "MmkvArguments.h"
+#include "MmkvBackgroundQueue.h"
+#include "MmkvChangeLog.h"
+#include "MmkvEntriesCursor.h"
+#include "MmkvFastBindings.h"
 #include "MmkvLogger.h"
+#include "MmkvNumbers.h"
+#include "MmkvQueue.h"
+#include "MmkvRecovery.h"
+#include "MmkvRingBuffer.h"
+#include "MmkvValueCompare.h"
 #include <MMKV.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <string>
 #include <vector>
 
 using namespace mmkv;
 using namespace facebook;
 
-MmkvHostObject::MmkvHostObject(const facebook::react::MMKVConfig& config) {
-  std::string path = config.path.has_value() ? config.path.value() : "";
-  std::string encryptionKey = config.encryptionKey.has_value() ? config.encryptionKey.value() : "";
+std::mutex MmkvHostObject::openFilesMutex;
+std::unordered_set<std::string> MmkvHostObject::openFiles;
+
+MmkvHostObject::MmkvHostObject(const facebook::react::MMKVConfig& config,
+                               std::shared_ptr<facebook::react::CallInvoker> callInvoker)
+    : callInvoker(callInvoker) {
+  path = config.path.has_value() ? config.path.value() : "";
+  encryptionKey = config.encryptionKey.has_value() ? config.encryptionKey.value() : "";
   bool hasEncryptionKey = encryptionKey.size() > 0;
   MmkvLogger::log("RNMMKV", "Creating MMKV instance \"%s\"... (Path: %s, Encrypted: %s)",
                   config.id.c_str(), path.c_str(), hasEncryptionKey ? "true" : "false");
 
   std::string* pathPtr = path.size() > 0 ? &path : nullptr;
   std::string* encryptionKeyPtr = encryptionKey.size() > 0 ? &encryptionKey : nullptr;
-  MMKVMode mode = getMMKVMode(config);
+  mode = getMMKVMode(config);
   if (config.readOnly.has_value() && config.readOnly.value()) {
     MmkvLogger::log("RNMMKV", "Instance is read-only!");
     mode = mode | MMKVMode::MMKV_READ_ONLY;
   }
+  // Mirrors replicate the changes recorded in the change log
+  bool hasChangeLog = (config.changeLog.has_value() && config.changeLog.value()) ||
+                      config.mirrorPath.has_value();
+  if (hasChangeLog && getMMKVMode(config) == MMKVMode::MMKV_MULTI_PROCESS) [[unlikely]] {
+    // The change log's sequence numbers are only kept in sync within one process.
+    throw std::runtime_error("Failed to create MMKV instance! `changeLog` and `mirrorPath` cannot "
+                             "be used in MULTI_PROCESS mode!");
+  }
 
-#ifdef __APPLE__
-  instance = MMKV::mmkvWithID(config.id, mode, encryptionKeyPtr, pathPtr);
-#else
-  instance = MMKV::mmkvWithID(config.id, DEFAULT_MMAP_SIZE, mode, encryptionKeyPtr, pathPtr);
-#endif
+  // MMKV reads the whole file on load, so let the kernel start reading it into the page-cache now
+  std::string rootPath = path.size() > 0 ? path : MMKV::getRootDir();
+  fileAdvisor = MmkvFileAdvisor(MmkvFileAdvisor::getFilePath(config.id, rootPath));
+  fileAdvisor.willNeed();
+
+  bool recoverOnCorruption =
+      config.recoverOnCorruption.has_value() && config.recoverOnCorruption.value();
+  auto openStart = std::chrono::steady_clock::now();
+  size_t recoveryCount;
+  {
+    MmkvRecovery::OpeningScope recoveryScope(recoverOnCorruption);
+    instance = openFile(config.id, mode, encryptionKeyPtr, pathPtr);
+    recoveryCount = recoveryScope.getRecoveryCount();
+  }
+  if (recoveryCount > 0) [[unlikely]] {
+    auto openDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - openStart);
+    MmkvLogger::log("RNMMKV", "Recovered MMKV instance \"%s\" in %lld ms (%zu keys left)",
+                    config.id.c_str(), static_cast<long long>(openDuration.count()),
+                    instance != nullptr ? instance->count() : 0);
+  }
 
   if (instance == nullptr) [[unlikely]] {
     // Check if instanceId is invalid
@@ -51,22 +95,79 @@ MmkvHostObject::MmkvHostObject(const facebook::react::MMKVConfig& config) {
 
     throw std::runtime_error("Failed to create MMKV instance!");
   }
+  // Multi-process instances are checked again when they reload changes of other processes.
+  MmkvRecovery::setRecoverOnCorruption(instance->mmapID(), recoverOnCorruption);
+
+  if (config.keyPrefixes.has_value()) {
+    keyCodec = MmkvKeyCodec(config.keyPrefixes.value());
+  }
+  if (!instance->isReadOnly()) {
+    // Re-encodes existing keys if `keyPrefixes` were added or changed since the last launch.
+    keyCodec.migrate(instance);
+  }
+
+  compareBeforeSet = config.compareBeforeSet.has_value() && config.compareBeforeSet.value();
+  compactNumbers = config.compactNumbers.has_value() && config.compactNumbers.value();
+
+  if (hasChangeLog) {
+    MMKV* changeLogStorage = openSiblingInstance(config.id + ".changelog");
+    if (changeLogStorage == nullptr) [[unlikely]] {
+      throw std::runtime_error("Failed to open change log of \"" + config.id + "\"!");
+    }
+    changeLog = std::make_shared<MmkvChangeLog>(changeLogStorage);
+  }
+  if (config.mirrorPath.has_value()) {
+    openMirror(config.id, config.mirrorPath.value());
+  }
+
+  if (config.overlayBasePath.has_value()) {
+    openOverlayBase(config.id, config.overlayBasePath.value());
+  }
+
+  if (config.startupWarmup.has_value() && config.startupWarmup.value()) {
+    // Prefetch what previous launches read at startup, and record what this launch reads.
+    startupProfile = std::make_shared<MmkvStartupProfile>(config.id);
+    startupProfile->start();
+    MMKV* mmkv = instance;
+    MMKV* baseFile = base;
+    MmkvBackgroundQueue::shared().dispatch([mmkv, baseFile, profile = startupProfile]() {
+      std::vector<std::string> keys = profile->loadPredictedKeys();
+      prefetchValues(mmkv, keys);
+      if (baseFile != nullptr) {
+        prefetchValues(baseFile, keys);
+      }
+    });
+  }
+
+  handle = MmkvFastBindings::registerInstance(this);
 }
 
 MmkvHostObject::~MmkvHostObject() {
+  MmkvFastBindings::unregisterInstance(handle);
   if (instance != nullptr) {
     std::string instanceId = instance->mmapID();
     MmkvLogger::log("RNMMKV", "Destroying MMKV instance \"%s\"...", instanceId.c_str());
-    instance->sync();
-    instance->clearMemoryCache();
+    if (startupProfile != nullptr) {
+      startupProfile->finish();
+    }
+    // Flushing to disk can take a while, and this usually runs on the JS thread during GC.
+    MMKV* mmkv = instance;
+    MmkvBackgroundQueue::shared().dispatch([mmkv]() {
+      mmkv->sync(MMKV_SYNC);
+      mmkv->clearMemoryCache();
+    });
   }
   instance = nullptr;
 }
 
 std::vector<jsi::PropNameID> MmkvHostObject::getPropertyNames(jsi::Runtime& rt) {
-  return jsi::PropNameID::names(rt, "set", "getBoolean", "getBuffer", "getString", "getNumber",
-                                "contains", "delete", "getAllKeys", "deleteAll", "recrypt", "trim",
-                                "size", "isReadOnly");
+  return jsi::PropNameID::names(rt, "set", "concatBuffer", "concatString", "getBoolean",
+                                "getBuffer", "getString", "getNumber", "getBigInt", "getValueSize",
+                                "getBufferRange", "contains", "delete", "registerKeys",
+                                "getAllKeys", "diff", "entries", "queue", "ringBuffer", "deleteAll",
+                                "recrypt", "changesSince", "truncateChangesBefore", "trim", "flush",
+                                "handleMemoryPressure", "prefetch", "size", "mirrorMetrics",
+                                "handle", "isReadOnly");
 }
 
 MMKVMode MmkvHostObject::getMMKVMode(const facebook::react::MMKVConfig& config) {
@@ -84,64 +185,502 @@ MMKVMode MmkvHostObject::getMMKVMode(const facebook::react::MMKVConfig& config)
   }
 }
 
+std::vector<std::string> MmkvHostObject::getKeysWithPrefix(std::vector<std::string> keys,
+                                                           const std::string& prefix,
+                                                           const MmkvKeyCodec& keyCodec) {
+  keys.erase(std::remove_if(keys.begin(), keys.end(),
+                            [&prefix, &keyCodec](const std::string& key) {
+                              if (MmkvKeyCodec::isReservedKey(key)) {
+                                return true;
+                              }
+                              const std::string decoded = keyCodec.decode(key);
+                              return decoded.compare(0, prefix.size(), prefix) != 0;
+                            }),
+             keys.end());
+  return keys;
+}
+
+void MmkvHostObject::prefetchValues(MMKV* mmkv, const std::vector<std::string>& keys) {
+  // Copying the raw value out touches every page it lives in, so later reads won't page-fault.
+  std::vector<uint8_t> scratch;
+  for (const std::string& key : keys) {
+    size_t size = mmkv->getValueSize(key, false);
+    if (size == 0) {
+      continue;
+    }
+    if (scratch.size() < size) {
+      scratch.resize(size);
+    }
+    mmkv->writeValueToBuffer(key, scratch.data(), static_cast<int32_t>(size));
+  }
+}
+
+void MmkvHostObject::releaseMemory(MMKV* mmkv, const MmkvFileAdvisor& fileAdvisor,
+                                   bool isCritical) {
+  // Small instances are cheap to keep around but not free to reload, so leave them be.
+  static constexpr size_t kMinimumReleasableSize = 1024 * 1024;
+  size_t mappedSize = mmkv->totalSize();
+  if (!isCritical && mappedSize < kMinimumReleasableSize) {
+    return;
+  }
+
+  if (isCritical && mmkv->actualSize() < mappedSize / 2) {
+    // More than half of the file is unused - shrinking it is worth it.
+    mmkv->trim();
+  }
+  mmkv->clearMemoryCache();
+  if (isCritical) {
+    fileAdvisor.dontNeed();
+  }
+  MmkvLogger::log("RNMMKV", "Released memory of MMKV instance \"%s\" (%s, %zu bytes mapped)",
+                  mmkv->mmapID().c_str(), isCritical ? "critical" : "moderate", mappedSize);
+}
+
+MMKV* MmkvHostObject::openFile(const std::string& id, MMKVMode mode, std::string* encryptionKey,
+                               std::string* rootPath) {
+#ifdef __APPLE__
+  MMKV* mmkv = MMKV::mmkvWithID(id, mode, encryptionKey, rootPath);
+#else
+  MMKV* mmkv = MMKV::mmkvWithID(id, DEFAULT_MMAP_SIZE, mode, encryptionKey, rootPath);
+#endif
+  if (mmkv != nullptr) {
+    std::lock_guard<std::mutex> lock(openFilesMutex);
+    openFiles.insert(getFileKey(id, rootPath));
+  }
+  return mmkv;
+}
+
+std::string MmkvHostObject::getFileKey(const std::string& id, const std::string* rootPath) {
+  std::string key = rootPath != nullptr ? *rootPath : MMKV::getRootDir();
+  while (key.size() > 1 && key.back() == '/') {
+    key.pop_back();
+  }
+  return key + "/" + id;
+}
+
+bool MmkvHostObject::isFileOpen(const std::string& fileKey) {
+  std::lock_guard<std::mutex> lock(openFilesMutex);
+  return openFiles.count(fileKey) > 0;
+}
+
+MMKV* MmkvHostObject::openSiblingInstance(const std::string& siblingId) {
+  // Siblings (e.g. queues) live next to this instance and use the same mode and encryption.
+  std::string* pathPtr = path.size() > 0 ? &path : nullptr;
+  std::string* encryptionKeyPtr = encryptionKey.size() > 0 ? &encryptionKey : nullptr;
+  return openFile(siblingId, mode, encryptionKeyPtr, pathPtr);
+}
+
+void MmkvHostObject::openOverlayBase(const std::string& id, const std::string& basePath) {
+  if (basePath == path) [[unlikely]] {
+    throw std::runtime_error("Failed to create MMKV instance! `overlayBasePath` cannot be the "
+                             "instance's own `path`!");
+  }
+
+  // The base file usually lives in the (read-only) app bundle - so it is never written to, and is
+  // opened single-process because multi-process mode would have to create a lock file next to it.
+  MMKVMode baseMode = MMKVMode::MMKV_SINGLE_PROCESS | MMKVMode::MMKV_READ_ONLY;
+  std::string baseRootPath = basePath;
+  std::string* encryptionKeyPtr = encryptionKey.size() > 0 ? &encryptionKey : nullptr;
+  MmkvFileAdvisor(MmkvFileAdvisor::getFilePath(id, basePath)).willNeed();
+  base = openFile(id, baseMode, encryptionKeyPtr, &baseRootPath);
+  if (base == nullptr) [[unlikely]] {
+    throw std::runtime_error("Failed to open overlay base file \"" + id + "\" in " + basePath +
+                             "!");
+  }
+
+  tombstoneStorage = openSiblingInstance(id + ".tombstones");
+  if (tombstoneStorage == nullptr) [[unlikely]] {
+    throw std::runtime_error("Failed to open overlay tombstones of \"" + id + "\"!");
+  }
+  std::vector<std::string> deletedKeys = tombstoneStorage->allKeys();
+  tombstones.insert(deletedKeys.begin(), deletedKeys.end());
+  MmkvLogger::log("RNMMKV", "Opened overlay base \"%s\" in %s (%zu keys, %zu deleted locally)",
+                  id.c_str(), basePath.c_str(), base->count(), tombstones.size());
+}
+
+void MmkvHostObject::openMirror(const std::string& id, const std::string& mirrorPath) {
+  std::string rootPath = path.size() > 0 ? path : MMKV::getRootDir();
+  if (mirrorPath == rootPath) [[unlikely]] {
+    throw std::runtime_error("Failed to create MMKV instance! `mirrorPath` cannot be the "
+                             "instance's own `path`!");
+  }
+  if (instance->isReadOnly()) [[unlikely]] {
+    throw std::runtime_error("Failed to create MMKV instance! Read-only instances cannot be "
+                             "mirrored!");
+  }
+
+  // The mirror is only ever written by this instance, from the background queue.
+  MMKVMode mirrorMode = MMKVMode::MMKV_SINGLE_PROCESS;
+  std::string mirrorRootPath = mirrorPath;
+  std::string* encryptionKeyPtr = encryptionKey.size() > 0 ? &encryptionKey : nullptr;
+  MMKV* mirrorInstance = openFile(id, mirrorMode, encryptionKeyPtr, &mirrorRootPath);
+  MMKV* mirrorState = openFile(id + ".mirror", mirrorMode, encryptionKeyPtr, &mirrorRootPath);
+  if (mirrorInstance == nullptr || mirrorState == nullptr) [[unlikely]] {
+    throw std::runtime_error("Failed to open mirror of \"" + id + "\" in " + mirrorPath + "!");
+  }
+
+  mirror = std::make_shared<MmkvMirror>(instance, changeLog, mirrorInstance, mirrorState);
+  // Catch up with changes that were not replicated before the app was closed.
+  mirror->onChange();
+}
+
+std::vector<std::string> MmkvHostObject::getAllKeys() {
+  std::vector<std::string> keys = instance->allKeys();
+  if (base != nullptr) {
+    std::lock_guard<std::mutex> lock(tombstonesMutex);
+    for (std::string& key : base->allKeys()) {
+      if (tombstones.count(key) == 0 && !instance->containsKey(key)) {
+        keys.push_back(std::move(key));
+      }
+    }
+  }
+  if (keyCodec.isEnabled()) {
+    keys.erase(std::remove_if(keys.begin(), keys.end(), MmkvKeyCodec::isReservedKey), keys.end());
+  }
+  return keys;
+}
+
+MmkvDiff::Side MmkvHostObject::getDiffSide() {
+  MmkvDiff::Side side;
+  for (std::string& key : getAllKeys()) {
+    std::string decodedKey = keyCodec.decode(key);
+    side.keys.emplace(std::move(decodedKey), std::move(key));
+  }
+  side.getInstance = [this](const std::string& storedKey) { return getReadInstance(storedKey); };
+  return side;
+}
+
+std::string MmkvHostObject::encodeKey(jsi::Runtime& runtime, const std::string& key) {
+  try {
+    return keyCodec.encode(key);
+  } catch (const std::invalid_argument& error) {
+    throw jsi::JSError(runtime, error.what());
+  }
+}
+
+void MmkvHostObject::removeKey(const std::string& key) {
+  onKeyDeleted(key);
+  {
+    // Logged before the key is removed, see MmkvChangeLog.
+    auto change = changeLog != nullptr ? changeLog->recordDelete(key)
+                                       : MmkvChangeLog::PendingChange();
+    instance->removeValueForKey(key);
+  }
+  onKeyRemoved(key);
+}
+
+void MmkvHostObject::onKeyWritten(const std::string& key) {
+  if (base != nullptr) {
+    std::lock_guard<std::mutex> lock(tombstonesMutex);
+    if (tombstones.erase(key) > 0) {
+      tombstoneStorage->removeValueForKey(key);
+    }
+  }
+  if (mirror != nullptr) {
+    mirror->onChange();
+  }
+  notifyNativeListeners(key);
+}
+
+void MmkvHostObject::onKeyRemoved(const std::string& key) {
+  if (mirror != nullptr) {
+    mirror->onChange();
+  }
+  notifyNativeListeners(key);
+}
+
+void MmkvHostObject::onKeyDeleted(const std::string& key) {
+  // Called before the overlay value is removed, so a crash in between can't resurrect the base.
+  if (base != nullptr && base->containsKey(key)) {
+    std::lock_guard<std::mutex> lock(tombstonesMutex);
+    if (tombstones.insert(key).second) {
+      tombstoneStorage->set(true, key);
+    }
+  }
+}
+
+void MmkvHostObject::notifyNativeListeners(const std::string& key) {
+  if (!hasNativeListeners) [[likely]] {
+    return;
+  }
+  std::vector<MmkvInstance::Listener> listeners;
+  {
+    std::lock_guard<std::mutex> lock(nativeListenersMutex);
+    listeners.reserve(nativeListeners.size());
+    for (const auto& entry : nativeListeners) {
+      listeners.push_back(entry.second);
+    }
+  }
+  // Called without holding the lock, so listeners can remove themselves.
+  std::string decodedKey = keyCodec.decode(key);
+  for (const MmkvInstance::Listener& listener : listeners) {
+    listener(decodedKey);
+  }
+}
+
+void MmkvHostObject::throwSetError(jsi::Runtime& runtime, const std::string& key) {
+  if (instance->isReadOnly()) {
+    throw jsi::JSError(runtime, "Failed to set " + key + "! This instance is read-only!");
+  } else {
+    throw jsi::JSError(runtime, "Failed to set " + key + "!");
+  }
+}
+
+jsi::Value MmkvHostObject::callSet(jsi::Runtime& runtime, const jsi::Value* arguments,
+                                   size_t count) {
+  if (count != 2 || !isKey(arguments[0])) [[unlikely]] {
+    throw jsi::JSError(runtime,
+                       "MMKV::set: First argument ('key') has to be of type string or KeyId!");
+  }
+
+  std::string keyStorage;
+  const std::string& keyName = getKeyName(runtime, arguments[0], keyStorage);
+  // Only set with `compareBeforeSet`: the instance to compare the current value with.
+  MMKV* current = compareBeforeSet ? getReadInstance(keyName) : nullptr;
+
+  bool successful = false;
+  if (arguments[1].isBool()) {
+    // bool
+    bool value = arguments[1].getBool();
+    if (current != nullptr && MmkvValueCompare::equals(current, value, keyName)) {
+      return jsi::Value(false);
+    }
+    successful = writeKey(keyName, [&] { return instance->set(value, keyName); });
+  } else if (arguments[1].isNumber()) {
+    // number
+    double value = arguments[1].getNumber();
+    if (current != nullptr &&
+        MmkvValueCompare::equals(current, value, keyName, compactNumbers)) {
+      return jsi::Value(false);
+    }
+    successful = writeKey(
+        keyName, [&] { return MmkvNumbers::set(instance, value, keyName, compactNumbers); });
+  } else if (arguments[1].isBigInt()) {
+    // bigint
+    jsi::BigInt bigint = arguments[1].getBigInt(runtime);
+    if (!bigint.isInt64(runtime)) [[unlikely]] {
+      throw jsi::JSError(runtime, "MMKV::set: 'value' BigInt does not fit into 64 bits!");
+    }
+    int64_t value = bigint.getInt64(runtime);
+    if (current != nullptr && MmkvValueCompare::equalsBigInt(current, value, keyName)) {
+      return jsi::Value(false);
+    }
+    successful = writeKey(
+        keyName, [&] { return MmkvNumbers::setBigInt(instance, value, keyName); });
+  } else if (arguments[1].isString()) {
+    // string
+    std::string stringValue = arguments[1].asString(runtime).utf8(runtime);
+    if (stringValue.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+        [[unlikely]] {
+      // MMKV's record format stores value lengths as 32-bit varints
+      throw jsi::JSError(runtime, "MMKV::set: 'value' string is too large (" +
+                                      std::to_string(stringValue.size()) + " bytes)!");
+    }
+    if (current != nullptr && MmkvValueCompare::equals(current, stringValue.data(),
+                                                       stringValue.size(), keyName)) {
+      return jsi::Value(false);
+    }
+    successful = writeKey(keyName, [&] { return instance->set(stringValue, keyName); });
+  } else if (arguments[1].isObject()) {
+    // object
+    jsi::Object object = arguments[1].asObject(runtime);
+    if (object.isArrayBuffer(runtime)) {
+      // ArrayBuffer
+      jsi::ArrayBuffer arrayBuffer = object.getArrayBuffer(runtime);
+      size_t size = arrayBuffer.size(runtime);
+      if (size > static_cast<size_t>(std::numeric_limits<int32_t>::max())) [[unlikely]] {
+        // MMKV's record format stores value lengths as 32-bit varints
+        throw jsi::JSError(runtime, "MMKV::set: 'value' buffer is too large (" +
+                                        std::to_string(size) + " bytes)!");
+      }
+      if (current != nullptr &&
+          MmkvValueCompare::equals(current, arrayBuffer.data(runtime), size, keyName)) {
+        return jsi::Value(false);
+      }
+      MMBuffer data(arrayBuffer.data(runtime), size, MMBufferNoCopy);
+      successful = writeKey(keyName, [&] { return instance->set(data, keyName); });
+    } else [[unlikely]] {
+      // unknown object
+      throw jsi::JSError(runtime,
+                         "MMKV::set: 'value' argument is an object, but not of type ArrayBuffer!");
+    }
+  } else [[unlikely]] {
+    // unknown type
+    throw jsi::JSError(runtime, "MMKV::set: 'value' argument is not of type bool, number, bigint, "
+                                "string or buffer!");
+  }
+
+  if (!successful) [[unlikely]] {
+    throwSetError(runtime, keyName);
+  }
+
+  return jsi::Value(true);
+}
+
+jsi::Value MmkvHostObject::callGetBoolean(jsi::Runtime& runtime, const jsi::Value* arguments,
+                                          size_t count) {
+  if (count != 1 || !isKey(arguments[0])) [[unlikely]] {
+    throw jsi::JSError(runtime, "First argument ('key') has to be of type string or KeyId!");
+  }
+
+  std::string keyStorage;
+  const std::string& keyName = getKeyName(runtime, arguments[0], keyStorage);
+  onKeyRead(keyName);
+  bool hasValue;
+  bool value = getReadInstance(keyName)->getBool(keyName, false, &hasValue);
+  if (!hasValue) [[unlikely]] {
+    return jsi::Value::undefined();
+  }
+  return jsi::Value(value);
+}
+
+jsi::Value MmkvHostObject::callGetNumber(jsi::Runtime& runtime, const jsi::Value* arguments,
+                                         size_t count) {
+  if (count != 1 || !isKey(arguments[0])) [[unlikely]] {
+    throw jsi::JSError(runtime, "First argument ('key') has to be of type string or KeyId!");
+  }
+
+  std::string keyStorage;
+  const std::string& keyName = getKeyName(runtime, arguments[0], keyStorage);
+  onKeyRead(keyName);
+  bool hasValue;
+  double value = MmkvNumbers::get(getReadInstance(keyName), keyName, &hasValue);
+  if (!hasValue) [[unlikely]] {
+    return jsi::Value::undefined();
+  }
+  return jsi::Value(value);
+}
+
+jsi::Value MmkvHostObject::callGetString(jsi::Runtime& runtime, const jsi::Value* arguments,
+                                         size_t count) {
+  if (count != 1 || !isKey(arguments[0])) [[unlikely]] {
+    throw jsi::JSError(runtime, "First argument ('key') has to be of type string or KeyId!");
+  }
+
+  std::string keyStorage;
+  const std::string& keyName = getKeyName(runtime, arguments[0], keyStorage);
+  onKeyRead(keyName);
+  std::string result;
+  bool hasValue = getReadInstance(keyName)->getString(keyName, result);
+  if (!hasValue) [[unlikely]] {
+    return jsi::Value::undefined();
+  }
+  return jsi::Value(runtime, jsi::String::createFromUtf8(runtime, result));
+}
+
+jsi::Value MmkvHostObject::callContains(jsi::Runtime& runtime, const jsi::Value* arguments,
+                                        size_t count) {
+  if (count != 1 || !isKey(arguments[0])) [[unlikely]] {
+    throw jsi::JSError(runtime, "First argument ('key') has to be of type string or KeyId!");
+  }
+
+  std::string keyStorage;
+  const std::string& keyName = getKeyName(runtime, arguments[0], keyStorage);
+  onKeyRead(keyName);
+  bool containsKey = getReadInstance(keyName)->containsKey(keyName);
+  return jsi::Value(containsKey);
+}
+
+jsi::Value MmkvHostObject::callDelete(jsi::Runtime& runtime, const jsi::Value* arguments,
+                                      size_t count) {
+  if (count != 1 || !isKey(arguments[0])) [[unlikely]] {
+    throw jsi::JSError(runtime, "First argument ('key') has to be of type string or KeyId!");
+  }
+
+  std::string keyStorage;
+  const std::string& keyName = getKeyName(runtime, arguments[0], keyStorage);
+  removeKey(keyName);
+  return jsi::Value::undefined();
+}
+
 jsi::Value MmkvHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID& propNameId) {
   std::string propName = propNameId.utf8(runtime);
 
   if (propName == "set") {
-    // MMKV.set(key: string, value: string | number | bool | ArrayBuffer)
+    // MMKV.set(key: string, value: string | number | bigint | bool | ArrayBuffer)
     return jsi::Function::createFromHostFunction(
         runtime, jsi::PropNameID::forAscii(runtime, propName),
         2, // key, value
         [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
                size_t count) -> jsi::Value {
-          if (count != 2 || !arguments[0].isString()) [[unlikely]] {
-            throw jsi::JSError(runtime,
-                               "MMKV::set: First argument ('key') has to be of type string!");
+          return callSet(runtime, arguments, count);
+        });
+  }
+
+  if (propName == "concatBuffer") {
+    // MMKV.concatBuffer(key: string, data: ArrayBuffer)
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        2, // key, data
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          if (count != 2 || !isKey(arguments[0])) [[unlikely]] {
+            throw jsi::JSError(runtime, "MMKV::concatBuffer: First argument ('key') has to be of "
+                                        "type string or KeyId!");
+          }
+          if (!arguments[1].isObject() || !arguments[1].asObject(runtime).isArrayBuffer(runtime))
+              [[unlikely]] {
+            throw jsi::JSError(runtime, "MMKV::concatBuffer: Second argument ('data') has to be of "
+                                        "type ArrayBuffer!");
           }
 
-          std::string keyName = arguments[0].asString(runtime).utf8(runtime);
+          std::string keyStorage;
+          const std::string& keyName = getKeyName(runtime, arguments[0], keyStorage);
+          jsi::ArrayBuffer arrayBuffer = arguments[1].asObject(runtime).getArrayBuffer(runtime);
+          size_t appendedSize = arrayBuffer.size(runtime);
 
-          bool successful = false;
-          if (arguments[1].isBool()) {
-            // bool
-            successful = instance->set(arguments[1].getBool(), keyName);
-          } else if (arguments[1].isNumber()) {
-            // number
-            successful = instance->set(arguments[1].getNumber(), keyName);
-          } else if (arguments[1].isString()) {
-            // string
-            std::string stringValue = arguments[1].asString(runtime).utf8(runtime);
-            successful = instance->set(stringValue, keyName);
-          } else if (arguments[1].isObject()) {
-            // object
-            jsi::Object object = arguments[1].asObject(runtime);
-            if (object.isArrayBuffer(runtime)) {
-              // ArrayBuffer
-              jsi::ArrayBuffer arrayBuffer = object.getArrayBuffer(runtime);
-              MMBuffer data(arrayBuffer.data(runtime), arrayBuffer.size(runtime), MMBufferNoCopy);
-              successful = instance->set(data, keyName);
-            } else [[unlikely]] {
-              // unknown object
-              throw jsi::JSError(
-                  runtime,
-                  "MMKV::set: 'value' argument is an object, but not of type ArrayBuffer!");
-            }
-          } else [[unlikely]] {
-            // unknown type
-            throw jsi::JSError(
-                runtime,
-                "MMKV::set: 'value' argument is not of type bool, number, string or buffer!");
+          // Concatenate natively, so the existing value never has to be copied into JS and back.
+          // This still reads and rewrites the whole value - MMKV cannot append to a value.
+          mmkv::MMBuffer existing;
+          bool hasValue = getReadInstance(keyName)->getBytes(keyName, existing);
+          size_t existingSize = hasValue ? existing.length() : 0;
+          size_t maxSize = static_cast<size_t>(std::numeric_limits<int32_t>::max());
+          if (existingSize + appendedSize > maxSize) [[unlikely]] {
+            throw jsi::JSError(runtime, "MMKV::concatBuffer: Value of " + keyName +
+                                            " would exceed the maximum value size!");
+          }
+          mmkv::MMBuffer combined(existingSize + appendedSize);
+          uint8_t* combinedData = static_cast<uint8_t*>(combined.getPtr());
+          if (existingSize > 0) {
+            std::memcpy(combinedData, existing.getPtr(), existingSize);
+          }
+          if (appendedSize > 0) {
+            std::memcpy(combinedData + existingSize, arrayBuffer.data(runtime), appendedSize);
           }
 
-          if (!successful) [[unlikely]] {
-            if (instance->isReadOnly()) {
-              throw jsi::JSError(runtime,
-                                 "Failed to set " + keyName + "! This instance is read-only!");
-            } else {
-              throw jsi::JSError(runtime, "Failed to set " + keyName + "!");
-            }
+          if (!writeKey(keyName, [&] { return instance->set(combined, keyName); })) [[unlikely]] {
+            throwSetError(runtime, keyName);
+          }
+          return jsi::Value::undefined();
+        });
+  }
+
+  if (propName == "concatString") {
+    // MMKV.concatString(key: string, text: string)
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        2, // key, text
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          if (count != 2 || !isKey(arguments[0]) || !arguments[1].isString()) [[unlikely]] {
+            throw jsi::JSError(runtime, "MMKV::concatString: Arguments ('key', 'text') have to be "
+                                        "of type string (or KeyId) and string!");
+          }
+
+          std::string keyStorage;
+          const std::string& keyName = getKeyName(runtime, arguments[0], keyStorage);
+          std::string value;
+          getReadInstance(keyName)->getString(keyName, value);
+          value += arguments[1].asString(runtime).utf8(runtime);
+          if (value.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+              [[unlikely]] {
+            throw jsi::JSError(runtime, "MMKV::concatString: Value of " + keyName +
+                                            " would exceed the maximum value size!");
           }
 
+          if (!writeKey(keyName, [&] { return instance->set(value, keyName); })) [[unlikely]] {
+            throwSetError(runtime, keyName);
+          }
           return jsi::Value::undefined();
         });
   }
@@ -153,17 +692,7 @@ jsi::Value MmkvHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID& pro
         1, // key
         [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
                size_t count) -> jsi::Value {
-          if (count != 1 || !arguments[0].isString()) [[unlikely]] {
-            throw jsi::JSError(runtime, "First argument ('key') has to be of type string!");
-          }
-
-          std::string keyName = arguments[0].asString(runtime).utf8(runtime);
-          bool hasValue;
-          bool value = instance->getBool(keyName, false, &hasValue);
-          if (!hasValue) [[unlikely]] {
-            return jsi::Value::undefined();
-          }
-          return jsi::Value(value);
+          return callGetBoolean(runtime, arguments, count);
         });
   }
 
@@ -174,17 +703,31 @@ jsi::Value MmkvHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID& pro
         1, // key
         [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
                size_t count) -> jsi::Value {
-          if (count != 1 || !arguments[0].isString()) [[unlikely]] {
-            throw jsi::JSError(runtime, "First argument ('key') has to be of type string!");
+          return callGetNumber(runtime, arguments, count);
+        });
+  }
+
+  if (propName == "getBigInt") {
+    // MMKV.getBigInt(key: string)
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        1, // key
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          if (count != 1 || !isKey(arguments[0])) [[unlikely]] {
+            throw jsi::JSError(runtime,
+                               "First argument ('key') has to be of type string or KeyId!");
           }
 
-          std::string keyName = arguments[0].asString(runtime).utf8(runtime);
+          std::string keyStorage;
+          const std::string& keyName = getKeyName(runtime, arguments[0], keyStorage);
+          onKeyRead(keyName);
           bool hasValue;
-          double value = instance->getDouble(keyName, 0.0, &hasValue);
+          int64_t value = MmkvNumbers::getBigInt(getReadInstance(keyName), keyName, &hasValue);
           if (!hasValue) [[unlikely]] {
             return jsi::Value::undefined();
           }
-          return jsi::Value(value);
+          return jsi::BigInt::fromInt64(runtime, value);
         });
   }
 
@@ -195,56 +738,124 @@ jsi::Value MmkvHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID& pro
         1, // key
         [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
                size_t count) -> jsi::Value {
-          if (count != 1 || !arguments[0].isString()) [[unlikely]] {
-            throw jsi::JSError(runtime, "First argument ('key') has to be of type string!");
+          return callGetString(runtime, arguments, count);
+        });
+  }
+
+  if (propName == "getBuffer") {
+    // MMKV.getBuffer(key: string)
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        1, // key
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          if (count != 1 || !isKey(arguments[0])) [[unlikely]] {
+            throw jsi::JSError(runtime,
+                               "First argument ('key') has to be of type string or KeyId!");
           }
 
-          std::string keyName = arguments[0].asString(runtime).utf8(runtime);
-          std::string result;
-          bool hasValue = instance->getString(keyName, result);
+          std::string keyStorage;
+          const std::string& keyName = getKeyName(runtime, arguments[0], keyStorage);
+          onKeyRead(keyName);
+          mmkv::MMBuffer buffer;
+          bool hasValue = getReadInstance(keyName)->getBytes(keyName, buffer);
           if (!hasValue) [[unlikely]] {
             return jsi::Value::undefined();
           }
-          return jsi::Value(runtime, jsi::String::createFromUtf8(runtime, result));
+          auto mutableData = std::make_shared<MMKVManagedBuffer>(std::move(buffer));
+          return jsi::ArrayBuffer(runtime, mutableData);
         });
   }
 
-  if (propName == "getBuffer") {
-    // MMKV.getBuffer(key: string)
+  if (propName == "getBufferRange") {
+    // MMKV.getBufferRange(key: string, offset: number, length: number)
     return jsi::Function::createFromHostFunction(
         runtime, jsi::PropNameID::forAscii(runtime, propName),
-        1, // key
+        3, // key, offset, length
         [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
                size_t count) -> jsi::Value {
-          if (count != 1 || !arguments[0].isString()) [[unlikely]] {
-            throw jsi::JSError(runtime, "First argument ('key') has to be of type string!");
+          if (count != 3 || !isKey(arguments[0])) [[unlikely]] {
+            throw jsi::JSError(runtime,
+                               "First argument ('key') has to be of type string or KeyId!");
+          }
+          auto isIndex = [](const jsi::Value& value) {
+            if (!value.isNumber()) {
+              return false;
+            }
+            double number = value.getNumber();
+            return std::isfinite(number) && number >= 0 && std::trunc(number) == number;
+          };
+          if (!isIndex(arguments[1]) || !isIndex(arguments[2])) [[unlikely]] {
+            throw jsi::JSError(runtime, "Arguments 'offset' and 'length' have to be non-negative "
+                                        "integers!");
           }
 
-          std::string keyName = arguments[0].asString(runtime).utf8(runtime);
+          std::string keyStorage;
+          const std::string& keyName = getKeyName(runtime, arguments[0], keyStorage);
+          onKeyRead(keyName);
+          // MMKV has no partial reads. getBytes() copies the whole value (and writeValueToBuffer()
+          // refuses buffers smaller than the value), so this costs O(value size) natively - only
+          // the window is copied into the buffer that JS gets.
           mmkv::MMBuffer buffer;
-          bool hasValue = instance->getBytes(keyName, buffer);
+          bool hasValue = getReadInstance(keyName)->getBytes(keyName, buffer);
           if (!hasValue) [[unlikely]] {
             return jsi::Value::undefined();
           }
-          auto mutableData = std::make_shared<MMKVManagedBuffer>(std::move(buffer));
+
+          // Both are integers in [0, size] after this, so they can be cast safely.
+          double size = static_cast<double>(buffer.length());
+          double offsetValue = arguments[1].getNumber();
+          double lengthValue = arguments[2].getNumber();
+          if (offsetValue > size || lengthValue > size - offsetValue) [[unlikely]] {
+            std::string valueSize = std::to_string(buffer.length());
+            throw jsi::JSError(runtime, "Arguments 'offset' and 'length' are out of bounds of the "
+                                        "value (" + valueSize + " bytes)!");
+          }
+
+          // Copy only the requested window, so the full value is freed when this returns.
+          size_t offset = static_cast<size_t>(offsetValue);
+          size_t length = static_cast<size_t>(lengthValue);
+          mmkv::MMBuffer range(length);
+          if (length > 0) {
+            std::memcpy(range.getPtr(), static_cast<uint8_t*>(buffer.getPtr()) + offset, length);
+          }
+          auto mutableData = std::make_shared<MMKVManagedBuffer>(std::move(range));
           return jsi::ArrayBuffer(runtime, mutableData);
         });
   }
 
-  if (propName == "contains") {
-    // MMKV.contains(key: string)
+  if (propName == "getValueSize") {
+    // MMKV.getValueSize(key: string)
     return jsi::Function::createFromHostFunction(
         runtime, jsi::PropNameID::forAscii(runtime, propName),
         1, // key
         [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
                size_t count) -> jsi::Value {
-          if (count != 1 || !arguments[0].isString()) [[unlikely]] {
-            throw jsi::JSError(runtime, "First argument ('key') has to be of type string!");
+          if (count != 1 || !isKey(arguments[0])) [[unlikely]] {
+            throw jsi::JSError(runtime,
+                               "First argument ('key') has to be of type string or KeyId!");
           }
 
-          std::string keyName = arguments[0].asString(runtime).utf8(runtime);
-          bool containsKey = instance->containsKey(keyName);
-          return jsi::Value(containsKey);
+          std::string keyStorage;
+          const std::string& keyName = getKeyName(runtime, arguments[0], keyStorage);
+          // For strings and buffers this is the size of the payload, without MMKV's length prefix
+          MMKV* source = getReadInstance(keyName);
+          size_t size = source->getValueSize(keyName, true);
+          if (size == 0 && !source->containsKey(keyName)) [[unlikely]] {
+            return jsi::Value::undefined();
+          }
+          return jsi::Value(static_cast<double>(size));
+        });
+  }
+
+  if (propName == "contains") {
+    // MMKV.contains(key: string)
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        1, // key
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          return callContains(runtime, arguments, count);
         });
   }
 
@@ -255,13 +866,39 @@ jsi::Value MmkvHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID& pro
         1, // key
         [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
                size_t count) -> jsi::Value {
-          if (count != 1 || !arguments[0].isString()) [[unlikely]] {
-            throw jsi::JSError(runtime, "First argument ('key') has to be of type string!");
+          return callDelete(runtime, arguments, count);
+        });
+  }
+
+  if (propName == "registerKeys") {
+    // MMKV.registerKeys(keys: string[]): KeyId[]
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        1, // keys
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          if (count != 1 || !arguments[0].isObject() ||
+              !arguments[0].asObject(runtime).isArray(runtime)) [[unlikely]] {
+            throw jsi::JSError(runtime, "First argument ('keys') has to be of type string[]!");
           }
 
-          std::string keyName = arguments[0].asString(runtime).utf8(runtime);
-          instance->removeValueForKey(keyName);
-          return jsi::Value::undefined();
+          jsi::Array keys = arguments[0].asObject(runtime).asArray(runtime);
+          size_t length = keys.size(runtime);
+          jsi::Array keyIds(runtime, length);
+          for (size_t i = 0; i < length; i++) {
+            jsi::Value key = keys.getValueAtIndex(runtime, i);
+            if (!key.isString()) [[unlikely]] {
+              throw jsi::JSError(runtime, "First argument ('keys') has to be of type string[]!");
+            }
+            std::string keyName = encodeKey(runtime, key.asString(runtime).utf8(runtime));
+            // Registering a key again returns its existing KeyId.
+            auto [entry, isNew] = registeredKeyIds.emplace(keyName, registeredKeys.size());
+            if (isNew) {
+              registeredKeys.push_back(std::move(keyName));
+            }
+            keyIds.setValueAtIndex(runtime, i, static_cast<double>(entry->second));
+          }
+          return keyIds;
         });
   }
 
@@ -271,22 +908,261 @@ jsi::Value MmkvHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID& pro
         runtime, jsi::PropNameID::forAscii(runtime, propName), 0,
         [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
                size_t count) -> jsi::Value {
-          std::vector<std::string> keys = instance->allKeys();
+          std::vector<std::string> keys = getAllKeys();
           jsi::Array array(runtime, keys.size());
-          for (int i = 0; i < keys.size(); i++) {
-            array.setValueAtIndex(runtime, i, keys[i]);
+          for (size_t i = 0; i < keys.size(); i++) {
+            array.setValueAtIndex(runtime, i, keyCodec.decode(keys[i]));
           }
           return array;
         });
   }
 
+  if (propName == "diff") {
+    // MMKV.diff(other: MMKV | { id: string, path: string, encryptionKey?: string,
+    //                           keyPrefixes?: string[] }): Diff
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        1, // other
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          if (count != 1 || !arguments[0].isObject()) [[unlikely]] {
+            throw jsi::JSError(runtime, "MMKV::diff: First argument ('other') has to be an MMKV "
+                                        "instance or an { id, path } object!");
+          }
+
+          auto toArray = [&runtime](const std::vector<std::string>& keys) {
+            jsi::Array array(runtime, keys.size());
+            for (size_t i = 0; i < keys.size(); i++) {
+              array.setValueAtIndex(runtime, i, jsi::String::createFromUtf8(runtime, keys[i]));
+            }
+            return array;
+          };
+          auto toDiff = [&runtime, &toArray](const MmkvDiff::Result& result) {
+            jsi::Object diff(runtime);
+            diff.setProperty(runtime, "added", toArray(result.added));
+            diff.setProperty(runtime, "removed", toArray(result.removed));
+            diff.setProperty(runtime, "changed", toArray(result.changed));
+            return diff;
+          };
+
+          jsi::Object other = arguments[0].asObject(runtime);
+          MmkvDiff::Result result;
+          if (other.isHostObject<MmkvHostObject>(runtime)) {
+            std::shared_ptr<MmkvHostObject> otherInstance =
+                other.getHostObject<MmkvHostObject>(runtime);
+            result = MmkvDiff::compute(getDiffSide(), otherInstance->getDiffSide());
+          } else {
+            // A file that is not open in JS, e.g. a freshly downloaded reference store
+            jsi::Value idValue = other.getProperty(runtime, "id");
+            jsi::Value pathValue = other.getProperty(runtime, "path");
+            if (!idValue.isString() || !pathValue.isString()) [[unlikely]] {
+              throw jsi::JSError(runtime, "MMKV::diff: 'other.id' and 'other.path' have to be of "
+                                          "type string!");
+            }
+            std::string otherId = idValue.asString(runtime).utf8(runtime);
+            std::string otherPath = pathValue.asString(runtime).utf8(runtime);
+            std::string otherKey;
+            jsi::Value keyValue = other.getProperty(runtime, "encryptionKey");
+            if (keyValue.isString()) {
+              otherKey = keyValue.asString(runtime).utf8(runtime);
+            }
+            MmkvKeyCodec otherCodec;
+            jsi::Value prefixesValue = other.getProperty(runtime, "keyPrefixes");
+            if (prefixesValue.isObject()) {
+              jsi::Array prefixesArray = prefixesValue.asObject(runtime).asArray(runtime);
+              std::vector<std::string> prefixes;
+              for (size_t i = 0; i < prefixesArray.size(runtime); i++) {
+                prefixes.push_back(
+                    prefixesArray.getValueAtIndex(runtime, i).asString(runtime).utf8(runtime));
+              }
+              try {
+                otherCodec = MmkvKeyCodec(std::move(prefixes));
+              } catch (const std::invalid_argument& error) {
+                throw jsi::JSError(runtime, error.what());
+              }
+            }
+
+            std::string otherFileKey = getFileKey(otherId, &otherPath);
+            std::string* pathPtr = path.size() > 0 ? &path : nullptr;
+            if (otherFileKey == getFileKey(instance->mmapID(), pathPtr)) {
+              // This instance's own file, which has no differences to itself.
+              return toDiff(MmkvDiff::Result());
+            }
+            // Files that are open elsewhere stay open (MMKV would hand out the same instance).
+            bool wasOpen = isFileOpen(otherFileKey);
+
+            MMKVMode otherMode = MMKVMode::MMKV_SINGLE_PROCESS | MMKVMode::MMKV_READ_ONLY;
+            std::string* otherKeyPtr = otherKey.size() > 0 ? &otherKey : nullptr;
+#ifdef __APPLE__
+            MMKV* otherFile = MMKV::mmkvWithID(otherId, otherMode, otherKeyPtr, &otherPath);
+#else
+            MMKV* otherFile =
+                MMKV::mmkvWithID(otherId, DEFAULT_MMAP_SIZE, otherMode, otherKeyPtr, &otherPath);
+#endif
+            if (otherFile == nullptr) [[unlikely]] {
+              throw jsi::JSError(runtime, "MMKV::diff: Failed to open \"" + otherId + "\" in " +
+                                              otherPath + "!");
+            }
+
+            MmkvDiff::Side otherSide;
+            for (std::string& key : otherFile->allKeys()) {
+              if (!MmkvKeyCodec::isReservedKey(key)) {
+                std::string decodedKey = otherCodec.decode(key);
+                otherSide.keys.emplace(std::move(decodedKey), std::move(key));
+              }
+            }
+            otherSide.getInstance = [otherFile](const std::string&) { return otherFile; };
+            result = MmkvDiff::compute(getDiffSide(), otherSide);
+            if (!wasOpen) {
+              otherFile->close();
+            }
+          }
+          return toDiff(result);
+        });
+  }
+
+  if (propName == "entries") {
+    // MMKV.entries(options?: { prefix?: string, chunkSize?: number, type?: ValueType })
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        1, // options
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          std::string prefix;
+          size_t chunkSize = 100;
+          MmkvValueType type = MmkvValueType::String;
+          if (count > 0 && !arguments[0].isUndefined()) {
+            if (!arguments[0].isObject()) [[unlikely]] {
+              throw jsi::JSError(runtime, "First argument ('options') has to be of type object!");
+            }
+            jsi::Object options = arguments[0].asObject(runtime);
+            jsi::Value prefixValue = options.getProperty(runtime, "prefix");
+            if (prefixValue.isString()) {
+              prefix = prefixValue.asString(runtime).utf8(runtime);
+            }
+            jsi::Value chunkSizeValue = options.getProperty(runtime, "chunkSize");
+            if (chunkSizeValue.isNumber()) {
+              double value = chunkSizeValue.asNumber();
+              if (!MmkvArguments::isIntegerInRange(value, 1, MmkvArguments::kMaxInt32))
+                  [[unlikely]] {
+                throw jsi::JSError(runtime, "'chunkSize' has to be an integer between 1 and "
+                                            "2147483647!");
+              }
+              chunkSize = static_cast<size_t>(value);
+            }
+            jsi::Value typeValue = options.getProperty(runtime, "type");
+            if (typeValue.isString()) {
+              type = MmkvEntriesCursor::parseValueType(runtime,
+                                                       typeValue.asString(runtime).utf8(runtime));
+            }
+          }
+
+          std::vector<std::string> keys =
+              prefix.empty() ? getAllKeys() : getKeysWithPrefix(getAllKeys(), prefix, keyCodec);
+          // The cursor keeps this instance alive, and reads every key from where it lives now.
+          auto getReadInstance = [self = shared_from_this()](const std::string& storedKey) {
+            return self->getReadInstance(storedKey);
+          };
+          auto cursor = std::make_shared<MmkvEntriesCursor>(getReadInstance, keyCodec,
+                                                            std::move(keys), type, chunkSize);
+          return jsi::Object::createFromHostObject(runtime, cursor);
+        });
+  }
+
+  if (propName == "queue") {
+    // MMKV.queue(name: string)
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        1, // name
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          if (count != 1 || !arguments[0].isString()) [[unlikely]] {
+            throw jsi::JSError(runtime, "First argument ('name') has to be of type string!");
+          }
+          std::string name = arguments[0].asString(runtime).utf8(runtime);
+          if (name.empty()) [[unlikely]] {
+            throw jsi::JSError(runtime, "Queue `name` cannot be empty!");
+          }
+
+          MMKV* storage = openSiblingInstance(instance->mmapID() + ".queue." + name);
+          if (storage == nullptr) [[unlikely]] {
+            throw jsi::JSError(runtime, "Failed to open queue \"" + name + "\"!");
+          }
+          return jsi::Object::createFromHostObject(runtime, std::make_shared<MmkvQueue>(storage));
+        });
+  }
+
+  if (propName == "ringBuffer") {
+    // MMKV.ringBuffer(name: string, capacity: number)
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        2, // name, capacity
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          if (count != 2 || !arguments[0].isString()) [[unlikely]] {
+            throw jsi::JSError(runtime, "First argument ('name') has to be of type string!");
+          }
+          if (!arguments[1].isNumber() ||
+              !MmkvArguments::isIntegerInRange(arguments[1].getNumber(), 1,
+                                               MmkvArguments::kMaxInt32)) [[unlikely]] {
+            throw jsi::JSError(runtime, "Second argument ('capacity') has to be a positive int32!");
+          }
+          std::string name = arguments[0].asString(runtime).utf8(runtime);
+          if (name.empty()) [[unlikely]] {
+            throw jsi::JSError(runtime, "Ring buffer `name` cannot be empty!");
+          }
+          if (instance->isReadOnly()) [[unlikely]] {
+            throw jsi::JSError(runtime, "Cannot open a ring buffer on a read-only instance!");
+          }
+
+          // Ring buffers are plain files next to this instance, not MMKV instances.
+          std::string rootPath = path.size() > 0 ? path : MMKV::getRootDir();
+          std::string filePath =
+              MmkvFileAdvisor::getFilePath(instance->mmapID() + ".ring." + name, rootPath);
+          if (filePath.empty()) [[unlikely]] {
+            throw jsi::JSError(runtime, "Ring buffer \"" + name +
+                                            "\" cannot be opened - the instance ID or name "
+                                            "contains special characters!");
+          }
+
+          size_t capacity = static_cast<size_t>(arguments[1].getNumber());
+          try {
+            return jsi::Object::createFromHostObject(
+                runtime, std::make_shared<MmkvRingBuffer>(filePath, capacity));
+          } catch (const std::runtime_error& error) {
+            throw jsi::JSError(runtime, error.what());
+          }
+        });
+  }
+
   if (propName == "clearAll") {
     // MMKV.clearAll()
     return jsi::Function::createFromHostFunction(
         runtime, jsi::PropNameID::forAscii(runtime, propName), 0,
         [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
                size_t count) -> jsi::Value {
-          instance->clearAll();
+          std::vector<std::string> clearedKeys;
+          if (hasNativeListeners || changeLog != nullptr) {
+            clearedKeys = getAllKeys();
+          }
+          if (base != nullptr) {
+            for (const std::string& key : base->allKeys()) {
+              onKeyDeleted(key);
+            }
+          }
+          {
+            // Logged before the keys are removed, see MmkvChangeLog.
+            auto change = changeLog != nullptr ? changeLog->recordDeletes(clearedKeys)
+                                               : MmkvChangeLog::PendingChange();
+            instance->clearAll();
+          }
+          if (keyCodec.isEnabled()) {
+            // clearAll() also removed the prefix list the next launch compares against.
+            keyCodec.writeSignature(instance);
+          }
+          for (const std::string& key : clearedKeys) {
+            onKeyRemoved(key);
+          }
           return jsi::Value::undefined();
         });
   }
@@ -326,14 +1202,243 @@ jsi::Value MmkvHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID& pro
         });
   }
 
+  if (propName == "changesSince") {
+    // MMKV.changesSince(sequence: number, limit?: number): ChangeSet
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        2, // sequence, limit
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          if (changeLog == nullptr) [[unlikely]] {
+            throw jsi::JSError(runtime, "MMKV::changesSince: This instance has no change log! "
+                                        "Create it with `changeLog: true`.");
+          }
+          if (count < 1 || count > 2 || !arguments[0].isNumber() ||
+              !MmkvArguments::isIntegerInRange(arguments[0].getNumber(), 0,
+                                               MmkvArguments::kMaxSafeInteger)) [[unlikely]] {
+            throw jsi::JSError(runtime, "MMKV::changesSince: First argument ('sequence') has to "
+                                        "be a non-negative integer!");
+          }
+          // Large enough to page through big stores quickly, small enough to not block JS.
+          static constexpr size_t kDefaultPageSize = 1000;
+          size_t limit = kDefaultPageSize;
+          if (count == 2 && !arguments[1].isUndefined()) {
+            if (!arguments[1].isNumber() || !(arguments[1].getNumber() >= 1)) [[unlikely]] {
+              throw jsi::JSError(runtime, "MMKV::changesSince: Second argument ('limit') has to "
+                                          "be a positive number!");
+            }
+            double maxLimit = static_cast<double>(std::numeric_limits<int32_t>::max());
+            limit = static_cast<size_t>(std::min(arguments[1].getNumber(), maxLimit));
+          }
+
+          int64_t nextSequence;
+          bool hasMore;
+          std::vector<MmkvChangeLog::Change> changes = changeLog->getChangesSince(
+              static_cast<int64_t>(arguments[0].getNumber()), limit, nextSequence, hasMore);
+
+          std::vector<std::string> changed;
+          std::vector<std::string> deleted;
+          for (MmkvChangeLog::Change& change : changes) {
+            (change.isDeleted ? deleted : changed).push_back(keyCodec.decode(change.key));
+          }
+          jsi::Array changedArray(runtime, changed.size());
+          for (size_t i = 0; i < changed.size(); i++) {
+            changedArray.setValueAtIndex(runtime, i,
+                                         jsi::String::createFromUtf8(runtime, changed[i]));
+          }
+          jsi::Array deletedArray(runtime, deleted.size());
+          for (size_t i = 0; i < deleted.size(); i++) {
+            deletedArray.setValueAtIndex(runtime, i,
+                                         jsi::String::createFromUtf8(runtime, deleted[i]));
+          }
+
+          jsi::Object result(runtime);
+          result.setProperty(runtime, "changed", std::move(changedArray));
+          result.setProperty(runtime, "deleted", std::move(deletedArray));
+          result.setProperty(runtime, "sequence", static_cast<double>(nextSequence));
+          result.setProperty(runtime, "hasMore", hasMore);
+          return result;
+        });
+  }
+
+  if (propName == "truncateChangesBefore") {
+    // MMKV.truncateChangesBefore(sequence: number): number
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName), 1,
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          if (changeLog == nullptr) [[unlikely]] {
+            throw jsi::JSError(runtime, "MMKV::truncateChangesBefore: This instance has no change "
+                                        "log! Create it with `changeLog: true`.");
+          }
+          if (count != 1 || !arguments[0].isNumber() ||
+              !MmkvArguments::isIntegerInRange(arguments[0].getNumber(), 0,
+                                               MmkvArguments::kMaxSafeInteger)) [[unlikely]] {
+            throw jsi::JSError(runtime, "MMKV::truncateChangesBefore: First argument "
+                                        "('sequence') has to be a non-negative integer!");
+          }
+
+          auto sequence = static_cast<int64_t>(arguments[0].getNumber());
+          if (mirror != nullptr) {
+            // The mirror still needs the changes it has not replicated yet.
+            sequence = std::min(sequence, mirror->getMetrics().sequence);
+          }
+          size_t removed = changeLog->truncateBefore(sequence);
+          return jsi::Value(static_cast<double>(removed));
+        });
+  }
+
   if (propName == "trim") {
     // MMKV.trim()
     return jsi::Function::createFromHostFunction(
         runtime, jsi::PropNameID::forAscii(runtime, propName), 0,
         [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
                size_t count) -> jsi::Value {
-          instance->clearMemoryCache();
+          // Trim first, otherwise trim() would load everything back into memory again
           instance->trim();
+          instance->clearMemoryCache();
+          fileAdvisor.dontNeed();
+          if (changeLog != nullptr) {
+            changeLog->trim();
+          }
+
+          return jsi::Value::undefined();
+        });
+  }
+
+  if (propName == "flush") {
+    // MMKV.flush(): Promise<void>
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName), 0,
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          MMKV* mmkv = instance;
+          auto invoker = callInvoker;
+          auto executor = jsi::Function::createFromHostFunction(
+              runtime, jsi::PropNameID::forAscii(runtime, "executor"),
+              2, // resolve, reject
+              [mmkv, invoker](jsi::Runtime& runtime, const jsi::Value& thisValue,
+                              const jsi::Value* arguments, size_t count) -> jsi::Value {
+                auto resolve = std::make_shared<jsi::Function>(
+                    arguments[0].asObject(runtime).asFunction(runtime));
+                auto reject = std::make_shared<jsi::Function>(
+                    arguments[1].asObject(runtime).asFunction(runtime));
+                // The callbacks are moved along so they are only ever released on the JS thread.
+                MmkvBackgroundQueue::shared().dispatch([mmkv, invoker, resolve = std::move(resolve),
+                                                        reject = std::move(reject)]() mutable {
+                  std::string error;
+                  try {
+                    mmkv->sync(MMKV_SYNC);
+                    if (!mmkv->isFileValid()) [[unlikely]] {
+                      error = "Failed to flush MMKV instance \"" + mmkv->mmapID() +
+                              "\" - the file is not valid!";
+                    }
+                  } catch (const std::exception& exception) {
+                    error = std::string("Failed to flush MMKV instance: ") + exception.what();
+                  }
+                  invoker->invokeAsync([resolve = std::move(resolve), reject = std::move(reject),
+                                        error = std::move(error)](jsi::Runtime& runtime) {
+                    if (error.empty()) [[likely]] {
+                      resolve->call(runtime);
+                    } else {
+                      jsi::Function errorConstructor =
+                          runtime.global().getPropertyAsFunction(runtime, "Error");
+                      jsi::String message = jsi::String::createFromUtf8(runtime, error);
+                      reject->call(runtime, errorConstructor.callAsConstructor(runtime, message));
+                    }
+                  });
+                });
+                return jsi::Value::undefined();
+              });
+
+          jsi::Function promise = runtime.global().getPropertyAsFunction(runtime, "Promise");
+          return promise.callAsConstructor(runtime, executor);
+        });
+  }
+
+  if (propName == "handleMemoryPressure") {
+    // MMKV.handleMemoryPressure(level: 'moderate' | 'critical')
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        1, // level
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          if (count != 1 || !arguments[0].isString()) [[unlikely]] {
+            throw jsi::JSError(runtime, "First argument ('level') has to be of type string!");
+          }
+
+          std::string level = arguments[0].asString(runtime).utf8(runtime);
+          bool isCritical;
+          if (level == "moderate") {
+            isCritical = false;
+          } else if (level == "critical") {
+            isCritical = true;
+          } else [[unlikely]] {
+            throw jsi::JSError(runtime, "Invalid memory pressure level \"" + level +
+                                            "\"! Expected \"moderate\" or \"critical\".");
+          }
+
+          MMKV* mmkv = instance;
+          MmkvBackgroundQueue::shared().dispatch([mmkv, advisor = fileAdvisor, isCritical]() {
+            releaseMemory(mmkv, advisor, isCritical);
+          });
+
+          return jsi::Value::undefined();
+        });
+  }
+
+  if (propName == "prefetch") {
+    // MMKV.prefetch(keysOrPrefix: string[] | string)
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        1, // keysOrPrefix
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          if (count != 1) [[unlikely]] {
+            throw jsi::JSError(runtime, "Expected 1 argument (keysOrPrefix), but received " +
+                                            std::to_string(count) + "!");
+          }
+
+          std::vector<std::string> keys;
+          std::string prefix;
+          bool hasPrefix = false;
+          if (arguments[0].isString()) {
+            // prefetch(prefix)
+            prefix = arguments[0].asString(runtime).utf8(runtime);
+            hasPrefix = true;
+          } else if (arguments[0].isObject() && arguments[0].asObject(runtime).isArray(runtime)) {
+            // prefetch([key1, key2, ...])
+            jsi::Array array = arguments[0].asObject(runtime).asArray(runtime);
+            size_t length = array.size(runtime);
+            keys.reserve(length);
+            for (size_t i = 0; i < length; i++) {
+              jsi::Value key = array.getValueAtIndex(runtime, i);
+              if (!key.isString()) [[unlikely]] {
+                throw jsi::JSError(runtime, "First argument ('keysOrPrefix') has to be of type "
+                                            "string or string[]!");
+              }
+              keys.push_back(encodeKey(runtime, key.asString(runtime).utf8(runtime)));
+            }
+          } else [[unlikely]] {
+            throw jsi::JSError(
+                runtime, "First argument ('keysOrPrefix') has to be of type string or string[]!");
+          }
+
+          // MMKV instances are cached for the lifetime of the process, so the raw pointers are safe
+          MMKV* mmkv = instance;
+          MMKV* baseFile = base;
+          MmkvBackgroundQueue::shared().dispatch([mmkv, baseFile, keys = std::move(keys),
+                                                  prefix = std::move(prefix), hasPrefix,
+                                                  keyCodec = keyCodec]() {
+            prefetchValues(mmkv,
+                           hasPrefix ? getKeysWithPrefix(mmkv->allKeys(), prefix, keyCodec) : keys);
+            if (baseFile != nullptr) {
+              // Keys that the overlay does not have are read from the base file.
+              prefetchValues(baseFile, hasPrefix ? getKeysWithPrefix(baseFile->allKeys(), prefix,
+                                                                     keyCodec)
+                                                 : keys);
+            }
+          });
 
           return jsi::Value::undefined();
         });
@@ -341,8 +1446,33 @@ jsi::Value MmkvHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID& pro
 
   if (propName == "size") {
     // MMKV.size
+    // JS numbers are doubles, which represent sizes up to 2^53 bytes exactly.
+    // An int would overflow at 2 GB.
     size_t size = instance->actualSize();
-    return jsi::Value(static_cast<int>(size));
+    return jsi::Value(static_cast<double>(size));
+  }
+
+  if (propName == "mirrorMetrics") {
+    // MMKV.mirrorMetrics
+    if (mirror == nullptr) {
+      return jsi::Value::undefined();
+    }
+    MmkvMirror::Metrics metrics = mirror->getMetrics();
+    jsi::Object result(runtime);
+    result.setProperty(runtime, "sequence", static_cast<double>(metrics.sequence));
+    result.setProperty(runtime, "lag", static_cast<double>(metrics.lag));
+    result.setProperty(runtime, "lagMs", metrics.lagMs);
+    result.setProperty(runtime, "replicatedChanges",
+                       static_cast<double>(metrics.replicatedChanges));
+    result.setProperty(runtime, "replicatedBytes", static_cast<double>(metrics.replicatedBytes));
+    result.setProperty(runtime, "changesPerSecond", metrics.changesPerSecond);
+    result.setProperty(runtime, "bytesPerSecond", metrics.bytesPerSecond);
+    return result;
+  }
+
+  if (propName == "handle") {
+    // MMKV.handle (for the `global.__mmkv` bindings)
+    return jsi::Value(static_cast<double>(handle));
   }
 
   if (propName == "isReadOnly") {
@@ -9,15 +9,34 @@
 #pragma once
 
 #include "MMKV.h"
+#include "MmkvChangeLog.h"
+#include "MmkvDiff.h"
+#include "MmkvFileAdvisor.h"
+#include "MmkvInstance.h"
+#include "MmkvKeyCodec.h"
+#include "MmkvMirror.h"
+#include "MmkvStartupProfile.h"
 #include "NativeMmkvModule.h"
+#include <atomic>
 #include <jsi/jsi.h>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace facebook;
 using namespace mmkv;
 
-class MmkvHostObject : public jsi::HostObject {
+class MmkvHostObject : public jsi::HostObject,
+                       public std::enable_shared_from_this<MmkvHostObject> {
+  // The public C++ API (MmkvInstance.h) wraps this host object.
+  friend class MmkvInstance;
+  // The handle-based bindings (MmkvFastBindings.h) call the call* methods directly.
+  friend class MmkvFastBindings;
+
 public:
-  MmkvHostObject(const facebook::react::MMKVConfig& config);
+  MmkvHostObject(const facebook::react::MMKVConfig& config,
+                 std::shared_ptr<facebook::react::CallInvoker> callInvoker);
   ~MmkvHostObject();
 
 public:
@@ -26,7 +45,123 @@ public:
 
 private:
   static MMKVMode getMMKVMode(const facebook::react::MMKVConfig& config);
+  static std::vector<std::string> getKeysWithPrefix(std::vector<std::string> keys,
+                                                    const std::string& prefix,
+                                                    const MmkvKeyCodec& keyCodec);
+  static void prefetchValues(MMKV* mmkv, const std::vector<std::string>& keys);
+  static void releaseMemory(MMKV* mmkv, const MmkvFileAdvisor& fileAdvisor, bool isCritical);
+  /**
+   Opens (or gets the already open) MMKV file, and remembers that it is open.
+   */
+  static MMKV* openFile(const std::string& id, MMKVMode mode, std::string* encryptionKey,
+                        std::string* rootPath);
+  static std::string getFileKey(const std::string& id, const std::string* rootPath);
+  static bool isFileOpen(const std::string& fileKey);
+  MMKV* openSiblingInstance(const std::string& siblingId);
+  [[noreturn]] void throwSetError(jsi::Runtime& runtime, const std::string& key);
+  void openOverlayBase(const std::string& id, const std::string& basePath);
+  void openMirror(const std::string& id, const std::string& mirrorPath);
+  std::vector<std::string> getAllKeys();
+  MmkvDiff::Side getDiffSide();
+  std::string encodeKey(jsi::Runtime& runtime, const std::string& key);
+  /**
+   Runs `write` (which returns whether it was successful) for the key, and logs it in the change
+   log first, if there is one.
+   */
+  template <typename Write> bool writeKey(const std::string& key, Write&& write) {
+    bool successful;
+    {
+      auto change = changeLog != nullptr ? changeLog->recordWrite(key)
+                                         : MmkvChangeLog::PendingChange();
+      successful = write();
+    }
+    if (successful) {
+      onKeyWritten(key);
+    }
+    return successful;
+  }
+  void removeKey(const std::string& key);
+  void onKeyWritten(const std::string& key);
+  void onKeyDeleted(const std::string& key);
+  void onKeyRemoved(const std::string& key);
+  void notifyNativeListeners(const std::string& key);
+  // Implementations of the hottest methods, shared with the handle-based bindings.
+  jsi::Value callSet(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count);
+  jsi::Value callGetBoolean(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count);
+  jsi::Value callGetNumber(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count);
+  jsi::Value callGetString(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count);
+  jsi::Value callContains(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count);
+  jsi::Value callDelete(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count);
+  static inline bool isKey(const jsi::Value& value) {
+    return value.isString() || value.isNumber();
+  }
+  // Resolves a string key, or a KeyId from registerKeys() (without converting any JS string).
+  inline const std::string& getKeyName(jsi::Runtime& runtime, const jsi::Value& key,
+                                       std::string& storage) {
+    if (key.isNumber()) {
+      double keyId = key.getNumber();
+      if (keyId >= 0 && keyId < registeredKeys.size() &&
+          keyId == static_cast<double>(static_cast<size_t>(keyId))) [[likely]] {
+        return registeredKeys[static_cast<size_t>(keyId)];
+      }
+      throw jsi::JSError(runtime, "First argument ('key') is not a registered KeyId!");
+    }
+    storage = key.asString(runtime).utf8(runtime);
+    if (keyCodec.isEnabled()) [[unlikely]] {
+      storage = encodeKey(runtime, storage);
+    }
+    return storage;
+  }
+  inline MMKV* getReadInstance(const std::string& key) {
+    // Overlay first, then tombstones (keys deleted locally), then the read-only base file.
+    if (base == nullptr) [[likely]] {
+      return instance;
+    }
+    std::lock_guard<std::mutex> lock(tombstonesMutex);
+    if (instance->containsKey(key) || tombstones.count(key) > 0) {
+      return instance;
+    }
+    return base;
+  }
+  inline void onKeyRead(const std::string& key) {
+    if (startupProfile != nullptr) {
+      startupProfile->recordAccess(key);
+    }
+  }
 
 private:
   MMKV* instance;
+  std::string path;
+  std::string encryptionKey;
+  MMKVMode mode;
+  std::shared_ptr<facebook::react::CallInvoker> callInvoker;
+  MmkvFileAdvisor fileAdvisor;
+  std::shared_ptr<MmkvStartupProfile> startupProfile;
+  MmkvKeyCodec keyCodec;
+  bool compareBeforeSet = false;
+  bool compactNumbers = false;
+  // Only set with `changeLog` or `mirrorPath`.
+  std::shared_ptr<MmkvChangeLog> changeLog;
+  // Only set with `mirrorPath`.
+  std::shared_ptr<MmkvMirror> mirror;
+  // This instance's handle in `global.__mmkv`.
+  size_t handle;
+  // Only set if this instance is an overlay over a read-only base file.
+  MMKV* base = nullptr;
+  MMKV* tombstoneStorage = nullptr;
+  std::unordered_set<std::string> tombstones;
+  // Guards `tombstones`, which the C++ API can modify from other threads.
+  std::mutex tombstonesMutex;
+  // Keys registered with registerKeys(), indexed by their KeyId.
+  std::vector<std::string> registeredKeys;
+  std::unordered_map<std::string, size_t> registeredKeyIds;
+  // Listeners added through the C++ API (MmkvInstance::addListener).
+  std::mutex nativeListenersMutex;
+  std::unordered_map<MmkvInstance::ListenerId, MmkvInstance::Listener> nativeListeners;
+  MmkvInstance::ListenerId nextNativeListenerId = 0;
+  std::atomic<bool> hasNativeListeners{false};
+  // The files opened by any instance (including siblings, overlay bases and mirrors). MMKV keeps
+  // them open until the process exits, so they are never removed.
+  static std::mutex openFilesMutex;
+  static std::unordered_set<std::string> openFiles;
 };
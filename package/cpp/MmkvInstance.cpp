@@ -0,0 +1,174 @@
+//
+//  MmkvInstance.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvInstance.h"
+#include "MmkvHostObject.h"
+#include "MmkvNumbers.h"
+#include "MmkvValueCompare.h"
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+MmkvInstance::MmkvInstance(std::string id, std::shared_ptr<MmkvHostObject> hostObject)
+    : id(std::move(id)), hostObject(std::move(hostObject)) {}
+
+bool MmkvInstance::isReadOnly() const {
+  return hostObject->instance->isReadOnly();
+}
+
+template <typename Equals, typename Set>
+bool MmkvInstance::write(const std::string& key, Equals&& equals, Set&& set) {
+  std::string encodedKey = hostObject->keyCodec.encode(key);
+  if (hostObject->compareBeforeSet && equals(hostObject->getReadInstance(encodedKey), encodedKey)) {
+    return false;
+  }
+  if (!hostObject->writeKey(encodedKey, [&] { return set(hostObject->instance, encodedKey); }))
+      [[unlikely]] {
+    throw std::runtime_error("Failed to set " + key + "!" +
+                             (isReadOnly() ? " This instance is read-only!" : ""));
+  }
+  return true;
+}
+
+bool MmkvInstance::setBoolean(const std::string& key, bool value) {
+  return write(
+      key,
+      [value](MMKV* mmkv, const std::string& k) {
+        return MmkvValueCompare::equals(mmkv, value, k);
+      },
+      [value](MMKV* mmkv, const std::string& k) { return mmkv->set(value, k); });
+}
+
+bool MmkvInstance::setNumber(const std::string& key, double value) {
+  bool compactNumbers = hostObject->compactNumbers;
+  return write(
+      key,
+      [value, compactNumbers](MMKV* mmkv, const std::string& k) {
+        return MmkvValueCompare::equals(mmkv, value, k, compactNumbers);
+      },
+      [value, compactNumbers](MMKV* mmkv, const std::string& k) {
+        return MmkvNumbers::set(mmkv, value, k, compactNumbers);
+      });
+}
+
+bool MmkvInstance::setInt64(const std::string& key, int64_t value) {
+  return write(
+      key,
+      [value](MMKV* mmkv, const std::string& k) {
+        return MmkvValueCompare::equalsBigInt(mmkv, value, k);
+      },
+      [value](MMKV* mmkv, const std::string& k) { return MmkvNumbers::setBigInt(mmkv, value, k); });
+}
+
+bool MmkvInstance::setString(const std::string& key, const std::string& value) {
+  return write(
+      key,
+      [&value](MMKV* mmkv, const std::string& k) {
+        return MmkvValueCompare::equals(mmkv, value.data(), value.size(), k);
+      },
+      [&value](MMKV* mmkv, const std::string& k) { return mmkv->set(value, k); });
+}
+
+bool MmkvInstance::setBuffer(const std::string& key, const void* data, size_t size) {
+  if (size > static_cast<size_t>(std::numeric_limits<int32_t>::max())) [[unlikely]] {
+    throw std::runtime_error("Failed to set " + key + "! The buffer is too large (" +
+                             std::to_string(size) + " bytes)!");
+  }
+  return write(
+      key,
+      [data, size](MMKV* mmkv, const std::string& k) {
+        return MmkvValueCompare::equals(mmkv, data, size, k);
+      },
+      [data, size](MMKV* mmkv, const std::string& k) {
+        mmkv::MMBuffer buffer(const_cast<void*>(data), size, mmkv::MMBufferNoCopy);
+        return mmkv->set(buffer, k);
+      });
+}
+
+std::optional<bool> MmkvInstance::getBoolean(const std::string& key) {
+  std::string encodedKey = hostObject->keyCodec.encode(key);
+  bool hasValue = false;
+  bool value = hostObject->getReadInstance(encodedKey)->getBool(encodedKey, false, &hasValue);
+  return hasValue ? std::optional<bool>(value) : std::nullopt;
+}
+
+std::optional<double> MmkvInstance::getNumber(const std::string& key) {
+  std::string encodedKey = hostObject->keyCodec.encode(key);
+  bool hasValue = false;
+  double value = MmkvNumbers::get(hostObject->getReadInstance(encodedKey), encodedKey, &hasValue);
+  return hasValue ? std::optional<double>(value) : std::nullopt;
+}
+
+std::optional<int64_t> MmkvInstance::getInt64(const std::string& key) {
+  std::string encodedKey = hostObject->keyCodec.encode(key);
+  bool hasValue = false;
+  int64_t value =
+      MmkvNumbers::getBigInt(hostObject->getReadInstance(encodedKey), encodedKey, &hasValue);
+  return hasValue ? std::optional<int64_t>(value) : std::nullopt;
+}
+
+std::optional<std::string> MmkvInstance::getString(const std::string& key) {
+  std::string encodedKey = hostObject->keyCodec.encode(key);
+  std::string value;
+  if (!hostObject->getReadInstance(encodedKey)->getString(encodedKey, value)) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+std::optional<mmkv::MMBuffer> MmkvInstance::getBuffer(const std::string& key) {
+  std::string encodedKey = hostObject->keyCodec.encode(key);
+  mmkv::MMBuffer value;
+  if (!hostObject->getReadInstance(encodedKey)->getBytes(encodedKey, value)) {
+    return std::nullopt;
+  }
+  return std::optional<mmkv::MMBuffer>(std::move(value));
+}
+
+int32_t MmkvInstance::readBuffer(const std::string& key, void* destination, size_t size) {
+  std::string encodedKey = hostObject->keyCodec.encode(key);
+  int32_t maxSize = static_cast<int32_t>(
+      std::min(size, static_cast<size_t>(std::numeric_limits<int32_t>::max())));
+  return hostObject->getReadInstance(encodedKey)->writeValueToBuffer(encodedKey, destination,
+                                                                     maxSize);
+}
+
+size_t MmkvInstance::getValueSize(const std::string& key) {
+  std::string encodedKey = hostObject->keyCodec.encode(key);
+  return hostObject->getReadInstance(encodedKey)->getValueSize(encodedKey, true);
+}
+
+bool MmkvInstance::contains(const std::string& key) {
+  std::string encodedKey = hostObject->keyCodec.encode(key);
+  return hostObject->getReadInstance(encodedKey)->containsKey(encodedKey);
+}
+
+void MmkvInstance::remove(const std::string& key) {
+  std::string encodedKey = hostObject->keyCodec.encode(key);
+  hostObject->removeKey(encodedKey);
+}
+
+std::vector<std::string> MmkvInstance::getAllKeys() {
+  std::vector<std::string> keys = hostObject->getAllKeys();
+  for (std::string& key : keys) {
+    key = hostObject->keyCodec.decode(key);
+  }
+  return keys;
+}
+
+MmkvInstance::ListenerId MmkvInstance::addListener(Listener listener) {
+  std::lock_guard<std::mutex> lock(hostObject->nativeListenersMutex);
+  ListenerId listenerId = hostObject->nextNativeListenerId++;
+  hostObject->nativeListeners.emplace(listenerId, std::move(listener));
+  hostObject->hasNativeListeners = true;
+  return listenerId;
+}
+
+void MmkvInstance::removeListener(ListenerId listenerId) {
+  std::lock_guard<std::mutex> lock(hostObject->nativeListenersMutex);
+  hostObject->nativeListeners.erase(listenerId);
+  hostObject->hasNativeListeners = !hostObject->nativeListeners.empty();
+}
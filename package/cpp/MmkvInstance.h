@@ -0,0 +1,78 @@
+//
+//  MmkvInstance.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKV.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+class MmkvHostObject;
+
+/**
+ Public C++ API of an MMKV instance that was created from JS, for other native modules
+ (TurboModules, JSI libraries) that want to use the same store without going through JS or opening
+ their own `MMKV*` handle.
+
+ Look instances up by their `id` with `facebook::react::NativeMmkvModule::getInstance(id)`. Keys are
+ plain keys as used in JS - `keyPrefixes`, `overlayBasePath` and `compareBeforeSet` are applied
+ just like for JS calls.
+
+ All methods can be called from any thread. Writes notify listeners added with `addListener(..)` on
+ the writing thread - both writes from JS and from C++. Listeners in JS are only notified of writes
+ from JS.
+ */
+class MmkvInstance {
+public:
+  using Listener = std::function<void(const std::string& key)>;
+  using ListenerId = size_t;
+
+  MmkvInstance(std::string id, std::shared_ptr<MmkvHostObject> hostObject);
+
+  const std::string& getId() const {
+    return id;
+  }
+  bool isReadOnly() const;
+
+  // Setters return `false` if the write was skipped because the value did not change
+  // (`compareBeforeSet`), and throw a std::runtime_error if the value cannot be written.
+  bool setBoolean(const std::string& key, bool value);
+  bool setNumber(const std::string& key, double value);
+  // Stored like a BigInt from JS, see MmkvNumbers.h.
+  bool setInt64(const std::string& key, int64_t value);
+  bool setString(const std::string& key, const std::string& value);
+  // The data is written into the file directly, without an intermediate copy.
+  bool setBuffer(const std::string& key, const void* data, size_t size);
+
+  std::optional<bool> getBoolean(const std::string& key);
+  std::optional<double> getNumber(const std::string& key);
+  std::optional<int64_t> getInt64(const std::string& key);
+  std::optional<std::string> getString(const std::string& key);
+  std::optional<mmkv::MMBuffer> getBuffer(const std::string& key);
+  // Copies the value straight from the mapped file into `destination`, which has to be at least
+  // `getValueSize(key)` bytes large. Returns the number of bytes copied, or -1 if there is no
+  // value or it does not fit.
+  int32_t readBuffer(const std::string& key, void* destination, size_t size);
+  size_t getValueSize(const std::string& key);
+
+  bool contains(const std::string& key);
+  void remove(const std::string& key);
+  std::vector<std::string> getAllKeys();
+
+  ListenerId addListener(Listener listener);
+  void removeListener(ListenerId listenerId);
+
+private:
+  template <typename Equals, typename Set>
+  bool write(const std::string& key, Equals&& equals, Set&& set);
+
+private:
+  std::string id;
+  std::shared_ptr<MmkvHostObject> hostObject;
+};
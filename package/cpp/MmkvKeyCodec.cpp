@@ -0,0 +1,183 @@
+//
+//  MmkvKeyCodec.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvKeyCodec.h"
+#include "MmkvLogger.h"
+#include "MmkvRawValue.h"
+#include <algorithm>
+#include <stdexcept>
+
+MmkvKeyCodec::MmkvKeyCodec(std::vector<std::string> prefixes) : _prefixes(std::move(prefixes)) {
+  if (_prefixes.size() > kMaxPrefixes) [[unlikely]] {
+    throw std::invalid_argument("`keyPrefixes` cannot contain more than " +
+                                std::to_string(kMaxPrefixes) + " prefixes!");
+  }
+  for (const std::string& prefix : _prefixes) {
+    if (prefix.empty() || prefix.find('\0') != std::string::npos) [[unlikely]] {
+      throw std::invalid_argument("`keyPrefixes` cannot contain empty prefixes or NUL characters!");
+    }
+  }
+}
+
+std::string MmkvKeyCodec::encode(const std::string& key) const {
+  if (_prefixes.empty()) {
+    return key;
+  }
+  if (!key.empty() && key[0] == kMarker) [[unlikely]] {
+    throw std::invalid_argument("Keys cannot start with \\x01 if `keyPrefixes` are used!");
+  }
+
+  // Longest matching prefix wins
+  size_t bestIndex = _prefixes.size();
+  size_t bestLength = 0;
+  for (size_t i = 0; i < _prefixes.size(); i++) {
+    const std::string& prefix = _prefixes[i];
+    if (prefix.size() > bestLength && key.compare(0, prefix.size(), prefix) == 0) {
+      bestIndex = i;
+      bestLength = prefix.size();
+    }
+  }
+  if (bestIndex == _prefixes.size() || bestLength <= 2) {
+    // No prefix, or one that is not longer than the two bytes it would be replaced with.
+    return key;
+  }
+
+  std::string storedKey;
+  storedKey.reserve(2 + key.size() - bestLength);
+  storedKey += kMarker;
+  storedKey += static_cast<char>(bestIndex + 1);
+  storedKey.append(key, bestLength, std::string::npos);
+  return storedKey;
+}
+
+std::string MmkvKeyCodec::decode(const std::string& storedKey) const {
+  if (storedKey.size() < 2 || storedKey[0] != kMarker) {
+    return storedKey;
+  }
+  size_t index = static_cast<uint8_t>(storedKey[1]) - 1;
+  if (index >= _prefixes.size()) [[unlikely]] {
+    // Stored with a prefix list that had more entries - keep it as-is.
+    return storedKey;
+  }
+  return _prefixes[index] + storedKey.substr(2);
+}
+
+std::string MmkvKeyCodec::getSignature() const {
+  std::string signature;
+  for (const std::string& prefix : _prefixes) {
+    signature += prefix;
+    signature += '\0';
+  }
+  return signature;
+}
+
+std::vector<std::string> MmkvKeyCodec::parseSignature(const std::string& signature) {
+  std::vector<std::string> prefixes;
+  size_t start = 0;
+  for (size_t end = signature.find('\0'); end != std::string::npos;
+       end = signature.find('\0', start)) {
+    prefixes.push_back(signature.substr(start, end - start));
+    start = end + 1;
+  }
+  return prefixes;
+}
+
+void MmkvKeyCodec::writeSignature(MMKV* mmkv) const {
+  const std::string signatureKey(1, kMarker);
+  std::string signature = getSignature();
+  if (signature.empty()) {
+    mmkv->removeValueForKey(signatureKey);
+  } else {
+    mmkv->set(signature, signatureKey);
+  }
+}
+
+void MmkvKeyCodec::moveValue(MMKV* mmkv, const std::string& from, const std::string& to) {
+  MmkvRawValue::copy(mmkv, from, mmkv, to);
+  mmkv->removeValueForKey(from);
+}
+
+size_t MmkvKeyCodec::reencode(MMKV* mmkv, const MmkvKeyCodec& previous) const {
+  size_t migrated = 0;
+  for (const std::string& storedKey : mmkv->allKeys()) {
+    if (isReservedKey(storedKey)) {
+      continue;
+    }
+    std::string key = previous.decode(storedKey);
+    if (!key.empty() && key[0] == kMarker) {
+      // Not encoded with `previous` - either already re-encoded, or with an unknown prefix list.
+      continue;
+    }
+    std::string newStoredKey = encode(key);
+    if (newStoredKey != storedKey) {
+      moveValue(mmkv, storedKey, newStoredKey);
+      migrated++;
+    }
+  }
+  return migrated;
+}
+
+void MmkvKeyCodec::migrate(MMKV* mmkv) const {
+  // The bookkeeping key holds the prefix list the keys are currently encoded with, the migration
+  // key the phase ('d'ecode or 'e'ncode) and prefix list of an unfinished migration.
+  const std::string signatureKey(1, kMarker);
+  const std::string migrationKey{kMarker, kMigrationMarker};
+  std::string signature = getSignature();
+
+  std::string migration;
+  if (!mmkv->getString(migrationKey, migration) || migration.empty()) {
+    std::string storedSignature;
+    bool hasSignature = mmkv->getString(signatureKey, storedSignature);
+    if (hasSignature ? storedSignature == signature : signature.empty()) {
+      return;
+    }
+
+    std::vector<std::string> previousPrefixes = parseSignature(storedSignature);
+    bool isAppendOnly =
+        previousPrefixes.size() <= _prefixes.size() &&
+        std::equal(previousPrefixes.begin(), previousPrefixes.end(), _prefixes.begin());
+    if (isAppendOnly) {
+      // Every stored key still decodes correctly with the new list, so keys can be re-encoded in
+      // place - and re-running an interrupted migration is safe.
+      size_t migrated = reencode(mmkv, *this);
+      writeSignature(mmkv);
+      MmkvLogger::log("RNMMKV", "Re-encoded %zu keys of \"%s\" for the new `keyPrefixes`",
+                      migrated, mmkv->mmapID().c_str());
+      return;
+    }
+
+    MmkvLogger::log("RNMMKV",
+                    "`keyPrefixes` of \"%s\" were reordered or removed - re-encoding all keys. "
+                    "Only append new prefixes to avoid this!",
+                    mmkv->mmapID().c_str());
+    migration = 'd' + storedSignature;
+    mmkv->set(migration, migrationKey);
+    mmkv->sync(MMKV_SYNC);
+  } else {
+    MmkvLogger::log("RNMMKV", "Resuming the interrupted `keyPrefixes` migration of \"%s\"",
+                    mmkv->mmapID().c_str());
+  }
+
+  // A key that was already moved can't be told apart from one that wasn't if both prefix lists
+  // are in use at once, so this happens in two phases that are each safe to re-run: first all
+  // keys are decoded with the old list, then all (now plain) keys are encoded with the new one.
+  char phase = migration[0];
+  std::string source = migration.substr(1);
+  if (phase == 'e' && source != signature) {
+    // Interrupted while encoding for a different prefix list - decode with that one first.
+    phase = 'd';
+  }
+  size_t migrated = 0;
+  if (phase == 'd') {
+    migrated += MmkvKeyCodec().reencode(mmkv, MmkvKeyCodec(parseSignature(source)));
+    mmkv->set('e' + signature, migrationKey);
+    mmkv->sync(MMKV_SYNC);
+  }
+  migrated += reencode(mmkv, MmkvKeyCodec());
+  writeSignature(mmkv);
+  mmkv->removeValueForKey(migrationKey);
+  MmkvLogger::log("RNMMKV", "Re-encoded %zu keys of \"%s\" for the new `keyPrefixes`", migrated,
+                  mmkv->mmapID().c_str());
+}
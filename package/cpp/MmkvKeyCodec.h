@@ -0,0 +1,77 @@
+//
+//  MmkvKeyCodec.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKV.h"
+#include <string>
+#include <vector>
+
+/**
+ Front-codes keys against a fixed list of shared prefixes (the `keyPrefixes` config option).
+
+ A key that starts with one of the prefixes is stored as `\x01`, the prefix's index (+1) as a
+ single byte, and the rest of the key - so e.g. `feature.onboarding.step.3.completed` takes 13
+ bytes instead of 35 in the file, in memory and in every CRC/load pass.
+ Keys that don't match a prefix are stored as-is.
+
+ Prefixes should only ever be appended to the list - reordering or removing them re-encodes every
+ key on the next launch. That migration records its progress in a second bookkeeping key, so it
+ resumes instead of renaming keys twice if the app is killed halfway through.
+ */
+class MmkvKeyCodec {
+public:
+  MmkvKeyCodec() = default;
+  /**
+   Throws a std::invalid_argument if there are too many prefixes, or one of them is empty.
+   */
+  explicit MmkvKeyCodec(std::vector<std::string> prefixes);
+
+public:
+  bool isEnabled() const {
+    return !_prefixes.empty();
+  }
+  /**
+   Encodes the key for storage. Throws a std::invalid_argument if it starts with the (reserved)
+   `\x01` character.
+   */
+  std::string encode(const std::string& key) const;
+  std::string decode(const std::string& storedKey) const;
+  /**
+   Whether the stored key is one of the codec's own bookkeeping keys, which are not user keys.
+   */
+  static bool isReservedKey(const std::string& storedKey) {
+    return (storedKey.size() == 1 && storedKey[0] == kMarker) ||
+           (storedKey.size() == 2 && storedKey[0] == kMarker && storedKey[1] == kMigrationMarker);
+  }
+  /**
+   Re-encodes all keys of the instance that were stored with a different (or no) prefix list.
+   This only iterates the keys if the prefix list changed since the last migration, or if a
+   previous migration was interrupted.
+   */
+  void migrate(MMKV* mmkv) const;
+  /**
+   Records the prefix list for already encoded keys, e.g. after `clearAll()` removed it.
+   */
+  void writeSignature(MMKV* mmkv) const;
+
+private:
+  static constexpr char kMarker = '\x01';
+  // Never a prefix index, since there are at most 254 prefixes (stored as 1...254).
+  static constexpr char kMigrationMarker = '\xFF';
+  static constexpr size_t kMaxPrefixes = 254;
+
+  std::string getSignature() const;
+  static std::vector<std::string> parseSignature(const std::string& signature);
+  /**
+   Moves every key that decodes with `previous` to its encoding with this codec. Keys that are
+   already encoded with this codec stay where they are, so this is safe to re-run.
+   */
+  size_t reencode(MMKV* mmkv, const MmkvKeyCodec& previous) const;
+  static void moveValue(MMKV* mmkv, const std::string& from, const std::string& to);
+
+private:
+  std::vector<std::string> _prefixes;
+};
@@ -5,6 +5,11 @@
 //  Created by Marc Rousavy on 25.03.24.
 //
 
+#pragma once
+
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
 #include <string>
 
 class MmkvLogger {
@@ -0,0 +1,128 @@
+//
+//  MmkvMirror.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvMirror.h"
+#include "MmkvBackgroundQueue.h"
+#include "MmkvLogger.h"
+#include "MmkvRawValue.h"
+#include <algorithm>
+#include <vector>
+
+// Stored in the mirror's state instance, next to the mirror.
+static const std::string kSequenceKey = "sequence";
+// The `keyPrefixes` bookkeeping key (see MmkvKeyCodec), which is not part of the change log.
+static const std::string kKeyCodecKey = "\x01";
+static constexpr size_t kPageSize = 1000;
+
+MmkvMirror::MmkvMirror(MMKV* source, std::shared_ptr<MmkvChangeLog> changeLog, MMKV* mirror,
+                       MMKV* state)
+    : _source(source), _changeLog(std::move(changeLog)), _mirror(mirror), _state(state),
+      _isScheduled(false), _isPending(false), _replicatedChanges(0), _replicatedBytes(0),
+      _busyTime(0) {
+  _sequence = _state->getInt64(kSequenceKey, 0);
+
+  std::string sourceCodec;
+  std::string mirrorCodec;
+  _source->getString(kKeyCodecKey, sourceCodec);
+  _mirror->getString(kKeyCodecKey, mirrorCodec);
+  bool isMirrorLost = _mirror->count() == 0 && _source->count() > 0;
+  if (sourceCodec != mirrorCodec || isMirrorLost || _sequence > _changeLog->getSequence()) {
+    // Keys were re-encoded, or the mirror (or change log) was replaced - start over.
+    _sequence = 0;
+  }
+}
+
+void MmkvMirror::onChange() {
+  if (_isScheduled.exchange(true)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_isPending) {
+      _isPending = true;
+      _pendingSince = std::chrono::steady_clock::now();
+    }
+  }
+  MmkvBackgroundQueue::shared().dispatch([self = shared_from_this()]() {
+    // Changes recorded from now on schedule another pass.
+    self->_isScheduled = false;
+    self->replicate();
+  });
+}
+
+void MmkvMirror::replicate() {
+  auto start = std::chrono::steady_clock::now();
+  int64_t sequence;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    sequence = _sequence;
+  }
+  size_t changes = 0;
+  size_t bytes = 0;
+
+  if (sequence == 0) {
+    // Everything up to the current sequence number is part of the full copy.
+    sequence = _changeLog->getSequence();
+    // A crash during the copy must not leave a half-copied mirror behind a replicated sequence
+    // number, so the state says "nothing replicated" until the copy is synced below.
+    _state->set(static_cast<int64_t>(0), kSequenceKey);
+    _state->sync(MMKV_SYNC);
+    _mirror->clearAll();
+    for (const std::string& key : _source->allKeys()) {
+      bytes += MmkvRawValue::copy(_source, key, _mirror, key);
+      changes++;
+    }
+    MmkvLogger::log("RNMMKV", "Copied %zu keys (%zu bytes) to the mirror of \"%s\"", changes,
+                    bytes, _source->mmapID().c_str());
+  }
+
+  bool hasMore = true;
+  while (hasMore) {
+    std::vector<MmkvChangeLog::Change> page =
+        _changeLog->getChangesSince(sequence, kPageSize, sequence, hasMore);
+    for (const MmkvChangeLog::Change& change : page) {
+      if (change.isDeleted || !_source->containsKey(change.key)) {
+        _mirror->removeValueForKey(change.key);
+      } else {
+        bytes += MmkvRawValue::copy(_source, change.key, _mirror, change.key);
+      }
+    }
+    changes += page.size();
+  }
+
+  // The values have to be on disk before the sequence number that says they are.
+  _mirror->sync(MMKV_SYNC);
+  _state->set(sequence, kSequenceKey);
+  _state->sync(MMKV_SYNC);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _sequence = sequence;
+  _replicatedChanges += changes;
+  _replicatedBytes += bytes;
+  _busyTime += std::chrono::steady_clock::now() - start;
+  if (_changeLog->getSequence() == sequence) {
+    _isPending = false;
+  }
+}
+
+MmkvMirror::Metrics MmkvMirror::getMetrics() {
+  int64_t latest = _changeLog->getSequence();
+  std::lock_guard<std::mutex> lock(_mutex);
+  double busySeconds = std::chrono::duration<double>(_busyTime).count();
+
+  Metrics metrics;
+  metrics.sequence = _sequence;
+  metrics.lag = std::max<int64_t>(latest - _sequence, 0);
+  metrics.lagMs = metrics.lag > 0 && _isPending
+                      ? std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - _pendingSince)
+                            .count()
+                      : 0;
+  metrics.replicatedChanges = _replicatedChanges;
+  metrics.replicatedBytes = _replicatedBytes;
+  metrics.changesPerSecond = busySeconds > 0 ? _replicatedChanges / busySeconds : 0;
+  metrics.bytesPerSecond = busySeconds > 0 ? _replicatedBytes / busySeconds : 0;
+  return metrics;
+}
@@ -0,0 +1,67 @@
+//
+//  MmkvMirror.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKV.h"
+#include "MmkvChangeLog.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ Keeps a mirror of an instance up to date on the background queue (the `mirrorPath` config
+ option), e.g. a backup copy or a copy in an App Group container.
+
+ Only the keys that changed since the last pass are copied, using the instance's change log. The
+ mirror's replicated sequence number is stored next to the mirror, and only after the copied values
+ have been synced to disk - so after a crash, the mirror replays some changes again, but never
+ misses one. The first pass (or one after the mirror was lost) copies all keys, after resetting the
+ stored sequence number - so a crash during the copy starts it over on the next launch.
+ */
+class MmkvMirror : public std::enable_shared_from_this<MmkvMirror> {
+public:
+  struct Metrics {
+    // The last sequence number that was replicated
+    int64_t sequence;
+    // How many changes have not been replicated yet, and for how long the oldest one has waited
+    int64_t lag;
+    double lagMs;
+    // Since the instance was opened
+    size_t replicatedChanges;
+    size_t replicatedBytes;
+    double changesPerSecond;
+    double bytesPerSecond;
+  };
+
+  MmkvMirror(MMKV* source, std::shared_ptr<MmkvChangeLog> changeLog, MMKV* mirror, MMKV* state);
+
+  /**
+   Schedules a replication pass on the background queue, unless one is already scheduled.
+   */
+  void onChange();
+  Metrics getMetrics();
+
+private:
+  void replicate();
+
+private:
+  MMKV* _source;
+  std::shared_ptr<MmkvChangeLog> _changeLog;
+  MMKV* _mirror;
+  MMKV* _state;
+  std::atomic<bool> _isScheduled;
+
+  std::mutex _mutex;
+  int64_t _sequence;
+  // Set while changes are waiting to be replicated
+  std::chrono::steady_clock::time_point _pendingSince;
+  bool _isPending;
+  size_t _replicatedChanges;
+  size_t _replicatedBytes;
+  std::chrono::steady_clock::duration _busyTime;
+};
@@ -0,0 +1,141 @@
+//
+//  MmkvNumbers.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKV.h"
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+/**
+ How JS numbers and BigInts are stored.
+
+ Numbers are stored as 8-byte doubles, just like MMKV's own `encode(double)`. Only instances with
+ the `compactNumbers` config option store integral numbers in [0, 2^49) - counters, IDs,
+ timestamps - as int64 varints of 1-7 bytes instead.
+
+ BigInts are stored as a length-delimited 8-byte little-endian int64 (9 bytes in total).
+
+ MMKV does not store types, so values are read back by their bytes - and some of them look the same:
+ - A value is length-delimited (a string, a buffer or a BigInt) if it starts with a varint length
+   that covers exactly the rest of the value. Those are not numbers - except for 9 bytes holding 8
+   bytes, which is a BigInt. An 8-byte string or buffer is read as a BigInt as well.
+ - Any other 8-byte value is a double. A double whose first (lowest) byte is 7 is indistinguishable
+   from a 7-byte string, and is read as a double: reading it as a string would make about one in
+   256 fractional doubles unreadable, while a 7-byte string read as a number is wrong either way.
+ - A single 0 byte is both an empty string and the varint 0, and is read as 0.
+ - Everything else is a varint (e.g. written by `compactNumbers` or native code).
+ */
+namespace MmkvNumbers {
+
+constexpr double kMaxVarintNumber = 562949953421312.0; // 2^49, the first 8-byte varint
+constexpr size_t kDoubleSize = sizeof(double);
+constexpr size_t kBigIntSize = sizeof(int64_t);
+constexpr size_t kBigIntStoredSize = kBigIntSize + 1; // 1-byte length prefix
+constexpr size_t kMaxVarintSize = 10;
+
+enum class Encoding { None, Double, BigInt, Varint };
+
+inline bool isVarint(double value) {
+  return value >= 0 && value < kMaxVarintNumber && std::trunc(value) == value &&
+         !std::signbit(value);
+}
+
+inline Encoding getEncoding(MMKV* mmkv, const std::string& key) {
+  size_t rawSize = mmkv->getValueSize(key, false);
+  if (rawSize == 0 || rawSize > kMaxVarintSize) {
+    return Encoding::None;
+  }
+  size_t actualSize = mmkv->getValueSize(key, true);
+  // Both ambiguous sizes are read as numbers (see above).
+  bool isLengthDelimited = actualSize != rawSize && rawSize != 1 && rawSize != kDoubleSize;
+  if (isLengthDelimited) {
+    return rawSize == kBigIntStoredSize && actualSize == kBigIntSize ? Encoding::BigInt
+                                                                      : Encoding::None;
+  }
+  return rawSize == kDoubleSize ? Encoding::Double : Encoding::Varint;
+}
+
+inline bool set(MMKV* mmkv, double value, const std::string& key, bool compactNumbers) {
+  if (compactNumbers && isVarint(value)) {
+    return mmkv->set(static_cast<int64_t>(value), key);
+  }
+  return mmkv->set(value, key);
+}
+
+inline void encodeBigInt(int64_t value, uint8_t (&bytes)[kBigIntSize]) {
+  uint64_t bits = static_cast<uint64_t>(value);
+  for (size_t i = 0; i < kBigIntSize; i++) {
+    bytes[i] = static_cast<uint8_t>(bits >> (i * 8));
+  }
+}
+
+inline bool setBigInt(MMKV* mmkv, int64_t value, const std::string& key) {
+  uint8_t bytes[kBigIntSize];
+  encodeBigInt(value, bytes);
+  mmkv::MMBuffer buffer(bytes, kBigIntSize, mmkv::MMBufferNoCopy);
+  return mmkv->set(buffer, key);
+}
+
+inline int64_t readBigInt(MMKV* mmkv, const std::string& key, bool* hasValue) {
+  mmkv::MMBuffer buffer;
+  if (!mmkv->getBytes(key, buffer) || buffer.length() != kBigIntSize) [[unlikely]] {
+    *hasValue = false;
+    return 0;
+  }
+  const uint8_t* bytes = static_cast<const uint8_t*>(buffer.getPtr());
+  uint64_t bits = 0;
+  for (size_t i = 0; i < kBigIntSize; i++) {
+    bits |= static_cast<uint64_t>(bytes[i]) << (i * 8);
+  }
+  *hasValue = true;
+  return static_cast<int64_t>(bits);
+}
+
+/**
+ Reads any stored number as a double. BigInts outside of ±2^53 lose precision.
+ */
+inline double get(MMKV* mmkv, const std::string& key, bool* hasValue) {
+  switch (getEncoding(mmkv, key)) {
+    case Encoding::Double:
+      return mmkv->getDouble(key, 0.0, hasValue);
+    case Encoding::BigInt:
+      return static_cast<double>(readBigInt(mmkv, key, hasValue));
+    case Encoding::Varint:
+      return static_cast<double>(mmkv->getInt64(key, 0, hasValue));
+    case Encoding::None:
+      break;
+  }
+  *hasValue = false;
+  return 0.0;
+}
+
+/**
+ Reads any stored number as an int64. Doubles are only read if they are integral and in range.
+ */
+inline int64_t getBigInt(MMKV* mmkv, const std::string& key, bool* hasValue) {
+  switch (getEncoding(mmkv, key)) {
+    case Encoding::Double: {
+      double value = mmkv->getDouble(key, 0.0, hasValue);
+      // 2^63 is the first double that does not fit into an int64
+      if (*hasValue && std::trunc(value) == value && value >= -9223372036854775808.0 &&
+          value < 9223372036854775808.0) {
+        return static_cast<int64_t>(value);
+      }
+      break;
+    }
+    case Encoding::BigInt:
+      return readBigInt(mmkv, key, hasValue);
+    case Encoding::Varint:
+      return mmkv->getInt64(key, 0, hasValue);
+    case Encoding::None:
+      break;
+  }
+  *hasValue = false;
+  return 0;
+}
+
+} // namespace MmkvNumbers
@@ -0,0 +1,206 @@
+//
+//  MmkvQueue.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvQueue.h"
+#include "MmkvArguments.h"
+#include "MmkvLogger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+
+static const std::string kHeadKey = "head";
+static const std::string kTailKey = "tail";
+
+static inline std::string getItemKey(int64_t index) {
+  return std::to_string(index);
+}
+
+static size_t getCountArgument(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
+  if (count != 1 || !arguments[0].isNumber() ||
+      !MmkvArguments::isIntegerInRange(arguments[0].getNumber(), 0,
+                                       MmkvArguments::kMaxSafeInteger)) [[unlikely]] {
+    throw jsi::JSError(runtime, "First argument ('count') has to be a non-negative integer!");
+  }
+  return static_cast<size_t>(arguments[0].getNumber());
+}
+
+static jsi::Array toJSIArray(jsi::Runtime& runtime, const std::vector<std::string>& items) {
+  jsi::Array array(runtime, items.size());
+  for (size_t i = 0; i < items.size(); i++) {
+    array.setValueAtIndex(runtime, i, jsi::String::createFromUtf8(runtime, items[i]));
+  }
+  return array;
+}
+
+MmkvQueue::MmkvQueue(MMKV* storage) : _storage(storage) {
+  removeUnreachableItems();
+}
+
+std::vector<jsi::PropNameID> MmkvQueue::getPropertyNames(jsi::Runtime& rt) {
+  return jsi::PropNameID::names(rt, "push", "peek", "pop", "size");
+}
+
+jsi::Value MmkvQueue::get(jsi::Runtime& runtime, const jsi::PropNameID& propNameId) {
+  std::string propName = propNameId.utf8(runtime);
+
+  if (propName == "push") {
+    // queue.push(items: string[])
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        1, // items
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          if (count != 1 || !arguments[0].isObject() ||
+              !arguments[0].asObject(runtime).isArray(runtime)) [[unlikely]] {
+            throw jsi::JSError(runtime, "First argument ('items') has to be of type string[]!");
+          }
+
+          jsi::Array array = arguments[0].asObject(runtime).asArray(runtime);
+          size_t length = array.size(runtime);
+          std::vector<std::string> items;
+          items.reserve(length);
+          for (size_t i = 0; i < length; i++) {
+            jsi::Value item = array.getValueAtIndex(runtime, i);
+            if (!item.isString()) [[unlikely]] {
+              throw jsi::JSError(runtime, "First argument ('items') has to be of type string[]!");
+            }
+            items.push_back(item.asString(runtime).utf8(runtime));
+          }
+
+          if (!push(items)) [[unlikely]] {
+            throw jsi::JSError(runtime, "Failed to push " + std::to_string(length) +
+                                            " items to the queue!");
+          }
+          return jsi::Value::undefined();
+        });
+  }
+
+  if (propName == "peek") {
+    // queue.peek(count: number): string[]
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        1, // count
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          size_t itemCount = getCountArgument(runtime, arguments, count);
+          return toJSIArray(runtime, peek(itemCount));
+        });
+  }
+
+  if (propName == "pop") {
+    // queue.pop(count: number): string[]
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        1, // count
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          size_t itemCount = getCountArgument(runtime, arguments, count);
+          return toJSIArray(runtime, pop(itemCount));
+        });
+  }
+
+  if (propName == "size") {
+    // queue.size
+    return jsi::Value(static_cast<double>(size()));
+  }
+
+  return jsi::Value::undefined();
+}
+
+int64_t MmkvQueue::getHead() {
+  return _storage->getInt64(kHeadKey, 0);
+}
+
+int64_t MmkvQueue::getTail() {
+  return _storage->getInt64(kTailKey, 0);
+}
+
+size_t MmkvQueue::size() {
+  std::lock_guard<MMKV> lock(*_storage);
+  int64_t head = getHead();
+  int64_t tail = getTail();
+  // A corrupted file can leave the head past the tail - the queue is empty then.
+  return tail > head ? static_cast<size_t>(tail - head) : 0;
+}
+
+bool MmkvQueue::push(const std::vector<std::string>& items) {
+  if (items.empty()) {
+    return true;
+  }
+  std::lock_guard<MMKV> lock(*_storage);
+  int64_t tail = getTail();
+  for (size_t i = 0; i < items.size(); i++) {
+    if (!_storage->set(items[i], getItemKey(tail + static_cast<int64_t>(i)))) [[unlikely]] {
+      return false;
+    }
+  }
+  // Only now the items become visible
+  return _storage->set(tail + static_cast<int64_t>(items.size()), kTailKey);
+}
+
+std::vector<std::string> MmkvQueue::peek(size_t count) {
+  // MMKV's lock is recursive, so pop() can call this while holding it.
+  std::lock_guard<MMKV> lock(*_storage);
+  int64_t head = getHead();
+  size_t available = std::min(count, size());
+  std::vector<std::string> items;
+  items.reserve(available);
+  for (size_t i = 0; i < available; i++) {
+    std::string item;
+    _storage->getString(getItemKey(head + static_cast<int64_t>(i)), item);
+    items.push_back(std::move(item));
+  }
+  return items;
+}
+
+std::vector<std::string> MmkvQueue::pop(size_t count) {
+  std::lock_guard<MMKV> lock(*_storage);
+  std::vector<std::string> items = peek(count);
+  if (items.empty()) {
+    return items;
+  }
+
+  int64_t head = getHead();
+  int64_t newHead = head + static_cast<int64_t>(items.size());
+  _storage->set(newHead, kHeadKey);
+
+  std::vector<std::string> keys;
+  keys.reserve(items.size());
+  for (int64_t index = head; index < newHead; index++) {
+    keys.push_back(getItemKey(index));
+  }
+  _storage->removeValuesForKeys(keys);
+  return items;
+}
+
+void MmkvQueue::removeUnreachableItems() {
+  if (_storage->isReadOnly()) {
+    return;
+  }
+  std::lock_guard<MMKV> lock(*_storage);
+  int64_t head = getHead();
+  int64_t tail = getTail();
+  // Everything but head, tail and the items in between has been left behind by a crash.
+  size_t expectedCount = tail > head ? static_cast<size_t>(tail - head) : 0;
+  expectedCount += _storage->containsKey(kHeadKey) ? 1 : 0;
+  expectedCount += _storage->containsKey(kTailKey) ? 1 : 0;
+  if (_storage->count() <= expectedCount) [[likely]] {
+    return;
+  }
+
+  std::vector<std::string> unreachableKeys;
+  for (const std::string& key : _storage->allKeys()) {
+    if (key == kHeadKey || key == kTailKey) {
+      continue;
+    }
+    int64_t index = std::strtoll(key.c_str(), nullptr, 10);
+    if (index < head || index >= tail) {
+      unreachableKeys.push_back(key);
+    }
+  }
+  MmkvLogger::log("RNMMKV", "Removing %zu unreachable queue items of \"%s\"...",
+                  unreachableKeys.size(), _storage->mmapID().c_str());
+  _storage->removeValuesForKeys(unreachableKeys);
+}
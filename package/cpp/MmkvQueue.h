@@ -0,0 +1,50 @@
+//
+//  MmkvQueue.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKV.h"
+#include <jsi/jsi.h>
+#include <string>
+#include <vector>
+
+using namespace facebook;
+using namespace mmkv;
+
+/**
+ A persistent FIFO queue of strings, stored in its own MMKV instance.
+
+ Items are stored under their (ever increasing) index, and the queue's `head` and `tail` indexes
+ are stored next to them. Items are always written before `tail` is moved past them, and `head` is
+ always moved before items are removed, so a crash can never expose a partially written or already
+ popped item - it can only leave unreachable items behind, which are cleaned up the next time the
+ queue is opened.
+
+ Every operation holds MMKV's instance lock (which is also an inter-process lock in MULTI_PROCESS
+ mode) while it reads and moves `head` and `tail`, so concurrent pushes and pops - from other
+ threads or processes - never see or claim the same index.
+ */
+class MmkvQueue : public jsi::HostObject {
+public:
+  explicit MmkvQueue(MMKV* storage);
+
+public:
+  jsi::Value get(jsi::Runtime&, const jsi::PropNameID& name) override;
+  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& rt) override;
+
+public:
+  bool push(const std::vector<std::string>& items);
+  std::vector<std::string> peek(size_t count);
+  std::vector<std::string> pop(size_t count);
+  size_t size();
+
+private:
+  int64_t getHead();
+  int64_t getTail();
+  void removeUnreachableItems();
+
+private:
+  MMKV* _storage;
+};
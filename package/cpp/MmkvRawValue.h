@@ -0,0 +1,131 @@
+//
+//  MmkvRawValue.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKV.h"
+#include "MmkvValueCompare.h"
+#include <cstring>
+#include <string>
+
+/**
+ Copies and compares values between keys or instances without knowing their type.
+
+ MMKV doesn't store types, so this works on the raw encoding: length-delimited (strings, buffers),
+ a varint (integers and booleans of any width), or fixed 8 or 4 bytes (doubles, floats). Some
+ encodings share their bytes (see MmkvNumbers.h), but each one is read back exactly as it was
+ stored, so copies and comparisons are byte for byte either way.
+ */
+namespace MmkvRawValue {
+
+enum class Encoding {
+  None,
+  LengthDelimited,
+  Varint,
+  Fixed64,
+  Fixed32,
+  // Not written by MMKV (e.g. a varint with padding) - can't be read back exactly.
+  Unknown,
+};
+
+inline Encoding getEncoding(MMKV* mmkv, const std::string& key) {
+  size_t rawSize = mmkv->getValueSize(key, false);
+  if (rawSize == 0) {
+    return Encoding::None;
+  }
+  // The sizes only differ if the value is a length prefix followed by exactly that many bytes.
+  if (mmkv->getValueSize(key, true) != rawSize) {
+    return Encoding::LengthDelimited;
+  }
+  // A varint only re-encodes to the same size if it is one - anything else decodes to a value of
+  // a different size, or stops early.
+  auto value = static_cast<uint64_t>(mmkv->getInt64(key));
+  if (MmkvValueCompare::getVarintSize(value) == rawSize) {
+    return Encoding::Varint;
+  }
+  switch (rawSize) {
+    case sizeof(double):
+      return Encoding::Fixed64;
+    case sizeof(float):
+      return Encoding::Fixed32;
+    default:
+      return Encoding::Unknown;
+  }
+}
+
+/**
+ Whether both values are stored with the same bytes. Missing values are equal, unknown ones never.
+ */
+inline bool equals(MMKV* a, const std::string& keyA, MMKV* b, const std::string& keyB) {
+  // Values that obviously changed are never read.
+  if (a->getValueSize(keyA, false) != b->getValueSize(keyB, false) ||
+      a->getValueSize(keyA, true) != b->getValueSize(keyB, true)) {
+    return false;
+  }
+  Encoding encoding = getEncoding(a, keyA);
+  if (encoding != getEncoding(b, keyB)) {
+    return false;
+  }
+  switch (encoding) {
+    case Encoding::None:
+      return true;
+    case Encoding::LengthDelimited: {
+      mmkv::MMBuffer bytesA = a->getBytes(keyA);
+      mmkv::MMBuffer bytesB = b->getBytes(keyB);
+      return bytesA.length() == bytesB.length() &&
+             std::memcmp(bytesA.getPtr(), bytesB.getPtr(), bytesA.length()) == 0;
+    }
+    case Encoding::Varint:
+      return a->getInt64(keyA) == b->getInt64(keyB);
+    case Encoding::Fixed64: {
+      // Bits, not values: NaNs with the same bits are equal, 0.0 and -0.0 are not.
+      double valueA = a->getDouble(keyA);
+      double valueB = b->getDouble(keyB);
+      return std::memcmp(&valueA, &valueB, sizeof(double)) == 0;
+    }
+    case Encoding::Fixed32: {
+      float valueA = a->getFloat(keyA);
+      float valueB = b->getFloat(keyB);
+      return std::memcmp(&valueA, &valueB, sizeof(float)) == 0;
+    }
+    case Encoding::Unknown:
+      return false;
+  }
+  return false;
+}
+
+/**
+ Copies the value with the same bytes and returns its stored size. If there is no value, `toKey` is
+ removed and 0 is returned - as it is if the value cannot be copied.
+ */
+inline size_t copy(MMKV* from, const std::string& fromKey, MMKV* to, const std::string& toKey) {
+  bool successful = false;
+  switch (getEncoding(from, fromKey)) {
+    case Encoding::None:
+      to->removeValueForKey(toKey);
+      return 0;
+    case Encoding::LengthDelimited: {
+      mmkv::MMBuffer buffer;
+      from->getBytes(fromKey, buffer);
+      successful = to->set(buffer, toKey);
+      break;
+    }
+    case Encoding::Varint:
+      // Re-encodes to the same bytes, whatever width it was written with.
+      successful = to->set(from->getInt64(fromKey), toKey);
+      break;
+    case Encoding::Fixed64:
+      successful = to->set(from->getDouble(fromKey), toKey);
+      break;
+    case Encoding::Fixed32:
+      successful = to->set(from->getFloat(fromKey), toKey);
+      break;
+    case Encoding::Unknown:
+      break;
+  }
+  return successful ? from->getValueSize(fromKey, false) : 0;
+}
+
+} // namespace MmkvRawValue
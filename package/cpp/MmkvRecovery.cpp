@@ -0,0 +1,67 @@
+//
+//  MmkvRecovery.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvRecovery.h"
+#include "MmkvLogger.h"
+#include <mutex>
+#include <unordered_set>
+
+using namespace mmkv;
+
+static std::mutex recoveryMutex;
+static std::unordered_set<std::string> recoveringInstances;
+// MMKV checks a file on the thread that opens it, so the scope of the opening thread applies.
+static thread_local MmkvRecovery::OpeningScope* currentOpeningScope = nullptr;
+
+MmkvRecovery::OpeningScope::OpeningScope(bool recover)
+    : _recover(recover), _previous(currentOpeningScope) {
+  currentOpeningScope = this;
+}
+
+MmkvRecovery::OpeningScope::~OpeningScope() {
+  currentOpeningScope = _previous;
+}
+
+void MmkvRecovery::install() {
+  MMKV::registerErrorHandler(onError);
+}
+
+void MmkvRecovery::setRecoverOnCorruption(const std::string& mmapID, bool recover) {
+  std::unique_lock lock(recoveryMutex);
+  if (recover) {
+    recoveringInstances.insert(mmapID);
+  } else {
+    recoveringInstances.erase(mmapID);
+  }
+}
+
+MMKVRecoverStrategic MmkvRecovery::onError(const std::string& mmapID, MMKVErrorType errorType) {
+  // Both errors are usually caused by a write-back that got interrupted. MMKV discards the whole
+  // instance by default - instances that opted in to recovery are decoded until the first broken
+  // record instead, and only the tail is dropped.
+  const char* reason = errorType == MMKVCRCCheckFail ? "CRC check failed" : "invalid file length";
+
+  OpeningScope* scope = currentOpeningScope;
+  bool recover;
+  if (scope != nullptr) {
+    recover = scope->_recover;
+  } else {
+    std::unique_lock lock(recoveryMutex);
+    recover = recoveringInstances.count(mmapID) > 0;
+  }
+
+  if (!recover) [[likely]] {
+    MmkvLogger::log("RNMMKV", "MMKV instance \"%s\" is corrupted (%s) - discarding it...",
+                    mmapID.c_str(), reason);
+    return OnErrorDiscard;
+  }
+
+  MmkvLogger::log("RNMMKV", "MMKV instance \"%s\" is corrupted (%s) - recovering valid records...",
+                  mmapID.c_str(), reason);
+  if (scope != nullptr) {
+    scope->_recoveryCount++;
+  }
+  return OnErrorRecover;
+}
@@ -0,0 +1,62 @@
+//
+//  MmkvRecovery.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKV.h"
+#include <string>
+
+/**
+ Decides how MMKV recovers instances whose file is corrupted (e.g. because the process was killed
+ during a full write-back), and keeps track of which instances had to be recovered.
+
+ MMKV identifies instances by their MMKV ID (`MMKV::mmapID()`), which is only the instance ID for
+ files in MMKV's root directory - files in a custom directory get a hash of their path instead.
+ That ID is only known once the instance is open, so the policy for opening an instance is set with
+ an `OpeningScope`, and the policy for later reloads (e.g. after another process wrote to the file)
+ with `setRecoverOnCorruption`.
+ */
+class MmkvRecovery {
+private:
+  MmkvRecovery() = delete;
+
+public:
+  /**
+   Applies a recovery policy to every instance that the calling thread opens while the scope is
+   alive, and counts how often they had to be recovered.
+   */
+  class OpeningScope {
+  public:
+    explicit OpeningScope(bool recover);
+    ~OpeningScope();
+    OpeningScope(const OpeningScope&) = delete;
+    OpeningScope& operator=(const OpeningScope&) = delete;
+
+    size_t getRecoveryCount() const {
+      return _recoveryCount;
+    }
+
+  private:
+    friend class MmkvRecovery;
+    bool _recover;
+    size_t _recoveryCount = 0;
+    OpeningScope* _previous;
+  };
+
+  /**
+   Registers the recovery handler with MMKV. Must be called after MMKV has been initialized.
+   */
+  static void install();
+
+  /**
+   Sets whether the valid records of the open, corrupted instance with the given MMKV ID should be
+   kept. Corrupted instances are discarded by default, like MMKV does without a handler.
+   */
+  static void setRecoverOnCorruption(const std::string& mmapID, bool recover);
+
+private:
+  static mmkv::MMKVRecoverStrategic onError(const std::string& mmapID,
+                                            mmkv::MMKVErrorType errorType);
+};
@@ -0,0 +1,91 @@
+//
+//  MmkvRingBuffer.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvRingBuffer.h"
+#include "MMKV.h"
+#include "MMKVManagedBuffer.h"
+#include "MmkvArguments.h"
+#include <algorithm>
+
+MmkvRingBuffer::MmkvRingBuffer(const std::string& path, size_t capacity)
+    : _file(path, capacity) {}
+
+std::vector<jsi::PropNameID> MmkvRingBuffer::getPropertyNames(jsi::Runtime& rt) {
+  return jsi::PropNameID::names(rt, "push", "last", "size", "capacity");
+}
+
+jsi::Value MmkvRingBuffer::get(jsi::Runtime& runtime, const jsi::PropNameID& propNameId) {
+  std::string propName = propNameId.utf8(runtime);
+
+  if (propName == "push") {
+    // ringBuffer.push(values: number | number[])
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        1, // values
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          if (count == 1 && arguments[0].isNumber()) {
+            _file.push(arguments[0].getNumber());
+            return jsi::Value::undefined();
+          }
+          if (count != 1 || !arguments[0].isObject() ||
+              !arguments[0].asObject(runtime).isArray(runtime)) [[unlikely]] {
+            throw jsi::JSError(runtime,
+                               "First argument ('values') has to be of type number or number[]!");
+          }
+
+          jsi::Array array = arguments[0].asObject(runtime).asArray(runtime);
+          size_t length = array.size(runtime);
+          for (size_t i = 0; i < length; i++) {
+            jsi::Value value = array.getValueAtIndex(runtime, i);
+            if (!value.isNumber()) [[unlikely]] {
+              throw jsi::JSError(runtime,
+                                 "First argument ('values') has to be of type number or number[]!");
+            }
+            _file.push(value.getNumber());
+          }
+          return jsi::Value::undefined();
+        });
+  }
+
+  if (propName == "last") {
+    // ringBuffer.last(count: number): Float64Array
+    return jsi::Function::createFromHostFunction(
+        runtime, jsi::PropNameID::forAscii(runtime, propName),
+        1, // count
+        [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+               size_t count) -> jsi::Value {
+          if (count != 1 || !arguments[0].isNumber() ||
+              !MmkvArguments::isIntegerInRange(arguments[0].getNumber(), 0,
+                                               MmkvArguments::kMaxSafeInteger)) [[unlikely]] {
+            throw jsi::JSError(runtime,
+                               "First argument ('count') has to be a non-negative integer!");
+          }
+
+          size_t requested =
+              std::min(static_cast<size_t>(arguments[0].getNumber()), _file.size());
+          mmkv::MMBuffer buffer(requested * sizeof(double));
+          _file.copyLast(requested, static_cast<double*>(buffer.getPtr()));
+
+          auto mutableData = std::make_shared<MMKVManagedBuffer>(std::move(buffer));
+          jsi::ArrayBuffer arrayBuffer(runtime, mutableData);
+          jsi::Function float64Array =
+              runtime.global().getPropertyAsFunction(runtime, "Float64Array");
+          return float64Array.callAsConstructor(runtime, arrayBuffer);
+        });
+  }
+
+  if (propName == "size") {
+    // ringBuffer.size
+    return jsi::Value(static_cast<double>(_file.size()));
+  }
+
+  if (propName == "capacity") {
+    // ringBuffer.capacity
+    return jsi::Value(static_cast<double>(_file.getCapacity()));
+  }
+
+  return jsi::Value::undefined();
+}
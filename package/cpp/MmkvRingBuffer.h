@@ -0,0 +1,28 @@
+//
+//  MmkvRingBuffer.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MmkvRingBufferFile.h"
+#include <jsi/jsi.h>
+#include <string>
+#include <vector>
+
+using namespace facebook;
+
+/**
+ A fixed-capacity, persistent ring buffer of numbers (doubles), backed by a `MmkvRingBufferFile`.
+ */
+class MmkvRingBuffer : public jsi::HostObject {
+public:
+  MmkvRingBuffer(const std::string& path, size_t capacity);
+
+public:
+  jsi::Value get(jsi::Runtime&, const jsi::PropNameID& name) override;
+  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& rt) override;
+
+private:
+  MmkvRingBufferFile _file;
+};
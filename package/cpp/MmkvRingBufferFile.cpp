@@ -0,0 +1,103 @@
+//
+//  MmkvRingBufferFile.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvRingBufferFile.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static constexpr uint32_t kMagic = 0x524E5242; // "RNRB"
+static constexpr uint32_t kVersion = 1;
+
+MmkvRingBufferFile::MmkvRingBufferFile(const std::string& path, size_t capacity)
+    : _capacity(capacity), _mapping(nullptr), _mappingSize(0) {
+  if (capacity == 0) [[unlikely]] {
+    throw std::runtime_error("Ring buffer capacity has to be at least 1!");
+  }
+
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+  if (fd < 0) [[unlikely]] {
+    throw std::runtime_error("Failed to open ring buffer file " + path + "! " +
+                             std::strerror(errno));
+  }
+
+  _mappingSize = sizeof(Header) + capacity * sizeof(double);
+  Header existing;
+  bool isInitialized = pread(fd, &existing, sizeof(Header), 0) == sizeof(Header) &&
+                       existing.magic == kMagic && existing.version == kVersion;
+  if (isInitialized) {
+    // Other ring buffers may have this file mapped - truncating it would crash them (SIGBUS).
+    if (existing.capacity != capacity) [[unlikely]] {
+      close(fd);
+      throw std::runtime_error("Ring buffer " + path + " already exists with a capacity of " +
+                               std::to_string(existing.capacity) + "!");
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) != _mappingSize)
+        [[unlikely]] {
+      close(fd);
+      throw std::runtime_error("Ring buffer file " + path + " is corrupted!");
+    }
+  } else if (ftruncate(fd, static_cast<off_t>(_mappingSize)) != 0) [[unlikely]] {
+    // A new file (or one whose creation was interrupted), which nobody has mapped yet.
+    close(fd);
+    throw std::runtime_error("Failed to allocate ring buffer file " + path + "! " +
+                             std::strerror(errno));
+  }
+
+  _mapping = mmap(nullptr, _mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (_mapping == MAP_FAILED) [[unlikely]] {
+    _mapping = nullptr;
+    throw std::runtime_error("Failed to map ring buffer file " + path + "! " +
+                             std::strerror(errno));
+  }
+
+  if (!isInitialized) {
+    Header* h = header();
+    std::memset(_mapping, 0, _mappingSize);
+    h->version = kVersion;
+    h->capacity = capacity;
+    h->head = 0;
+    // The magic is written last, so a half-initialized header is never considered valid.
+    std::atomic_thread_fence(std::memory_order_release);
+    h->magic = kMagic;
+  }
+}
+
+MmkvRingBufferFile::~MmkvRingBufferFile() {
+  if (_mapping != nullptr) {
+    munmap(_mapping, _mappingSize);
+  }
+}
+
+void MmkvRingBufferFile::push(double value) {
+  Header* h = header();
+  samples()[h->head % _capacity] = value;
+  // The sample has to be in place before it becomes visible through `head`.
+  std::atomic_thread_fence(std::memory_order_release);
+  h->head++;
+}
+
+size_t MmkvRingBufferFile::size() const {
+  return static_cast<size_t>(std::min<uint64_t>(header()->head, _capacity));
+}
+
+size_t MmkvRingBufferFile::copyLast(size_t count, double* destination) const {
+  uint64_t head = header()->head;
+  size_t available = std::min(count, size());
+  // Copy in (at most) two contiguous runs, oldest sample first.
+  size_t start = static_cast<size_t>((head - available) % _capacity);
+  size_t firstRun = std::min(available, _capacity - start);
+  std::memcpy(destination, samples() + start, firstRun * sizeof(double));
+  std::memcpy(destination + firstRun, samples(), (available - firstRun) * sizeof(double));
+  return available;
+}
@@ -0,0 +1,64 @@
+//
+//  MmkvRingBufferFile.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ The preallocated, memory-mapped file that backs a `MmkvRingBuffer`.
+
+ Samples are overwritten in place - so pushing a sample is O(1), and never grows the file or causes
+ a compaction. Samples are written to a shared mapping of the file and never `msync`ed: they survive
+ the app being killed or crashing, but samples that the OS has not written back yet are lost if the
+ device loses power or the OS crashes.
+ */
+class MmkvRingBufferFile {
+public:
+  /**
+   Opens the ring buffer file at `path`, or creates it if it does not exist yet.
+   Throws if the file already holds a ring buffer with a different capacity - the file may be mapped
+   elsewhere, so it can't be resized.
+   */
+  MmkvRingBufferFile(const std::string& path, size_t capacity);
+  ~MmkvRingBufferFile();
+  MmkvRingBufferFile(const MmkvRingBufferFile&) = delete;
+  MmkvRingBufferFile& operator=(const MmkvRingBufferFile&) = delete;
+
+public:
+  void push(double value);
+  size_t size() const;
+  size_t getCapacity() const {
+    return _capacity;
+  }
+  /**
+   Copies the last `count` samples (oldest first) into `destination`, and returns how many it
+   copied.
+   */
+  size_t copyLast(size_t count, double* destination) const;
+
+private:
+  struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    // The total number of samples ever pushed - the next sample is written to `head % capacity`.
+    uint64_t head;
+  };
+
+  Header* header() const {
+    return static_cast<Header*>(_mapping);
+  }
+  double* samples() const {
+    return reinterpret_cast<double*>(static_cast<uint8_t*>(_mapping) + sizeof(Header));
+  }
+
+private:
+  size_t _capacity;
+  void* _mapping;
+  size_t _mappingSize;
+};
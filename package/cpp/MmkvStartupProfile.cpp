@@ -0,0 +1,111 @@
+//
+//  MmkvStartupProfile.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvStartupProfile.h"
+#include "MmkvBackgroundQueue.h"
+#include "MmkvLogger.h"
+#include <algorithm>
+
+using namespace mmkv;
+
+// How long after creating an instance reads are being recorded.
+static constexpr auto kStartupWindow = std::chrono::seconds(5);
+// A key gains a point in each launch it is read in (up to this), and loses one otherwise.
+static constexpr int kMaxScore = 3;
+// Keys that are read at startup are usually few - don't let a full scan bloat the profile.
+static constexpr size_t kMaxRecordedKeys = 512;
+
+MmkvStartupProfile::MmkvStartupProfile(std::string instanceId)
+    : _instanceId(std::move(instanceId)),
+      _deadline(std::chrono::steady_clock::now() + kStartupWindow), _isRecording(true) {}
+
+void MmkvStartupProfile::start() {
+  std::weak_ptr<MmkvStartupProfile> weakSelf = weak_from_this();
+  MmkvBackgroundQueue::shared().dispatchAfter(kStartupWindow, [weakSelf]() {
+    if (auto self = weakSelf.lock()) {
+      self->finish();
+    }
+  });
+}
+
+void MmkvStartupProfile::recordAccessWhileRecording(const std::string& key) {
+  {
+    std::unique_lock lock(_mutex);
+    if (std::chrono::steady_clock::now() <= _deadline && _accessedKeys.size() < kMaxRecordedKeys) {
+      _accessedKeys.insert(key);
+      return;
+    }
+  }
+  finish();
+}
+
+void MmkvStartupProfile::finish() {
+  if (!_isRecording.exchange(false)) {
+    return;
+  }
+
+  // The profile stays alive until it has been saved, even if the instance is destroyed before that.
+  auto self = shared_from_this();
+  MmkvBackgroundQueue::shared().dispatch([self]() { self->save(); });
+}
+
+std::vector<std::string> MmkvStartupProfile::loadPredictedKeys() {
+  MMKV* storage = getProfileStorage();
+  if (storage == nullptr) [[unlikely]] {
+    return {};
+  }
+
+  std::vector<std::string> entries;
+  storage->getVector(_instanceId, entries);
+
+  std::vector<std::string> keys;
+  keys.reserve(entries.size());
+  for (const std::string& entry : entries) {
+    // Each entry is "<score>:<key>"
+    if (entry.size() < 2 || entry[1] != ':') [[unlikely]] {
+      continue;
+    }
+    int score = entry[0] - '0';
+    std::string key = entry.substr(2);
+    _scores[key] = score;
+    keys.push_back(std::move(key));
+  }
+  return keys;
+}
+
+void MmkvStartupProfile::save() {
+  MMKV* storage = getProfileStorage();
+  if (storage == nullptr) [[unlikely]] {
+    return;
+  }
+
+  std::unique_lock lock(_mutex);
+  for (auto& [key, score] : _scores) {
+    score = _accessedKeys.count(key) > 0 ? std::min(score + 1, kMaxScore) : score - 1;
+  }
+  for (const std::string& key : _accessedKeys) {
+    _scores.try_emplace(key, 1);
+  }
+
+  std::vector<std::string> entries;
+  entries.reserve(_scores.size());
+  for (const auto& [key, score] : _scores) {
+    if (score > 0) {
+      entries.push_back(std::to_string(score) + ":" + key);
+    }
+  }
+  storage->set(entries, _instanceId);
+  MmkvLogger::log("RNMMKV", "Saved startup profile for \"%s\" (%zu keys)", _instanceId.c_str(),
+                  entries.size());
+}
+
+MMKV* MmkvStartupProfile::getProfileStorage() {
+  static const std::string profileStorageId = "rnmmkv.startup-profiles";
+#ifdef __APPLE__
+  return MMKV::mmkvWithID(profileStorageId, MMKV_SINGLE_PROCESS);
+#else
+  return MMKV::mmkvWithID(profileStorageId, DEFAULT_MMAP_SIZE, MMKV_SINGLE_PROCESS);
+#endif
+}
@@ -0,0 +1,68 @@
+//
+//  MmkvStartupProfile.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKV.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ Records which keys of an MMKV instance are read shortly after it has been created, and remembers
+ them across launches so they can be prefetched on the next launch before JS asks for them.
+ */
+class MmkvStartupProfile : public std::enable_shared_from_this<MmkvStartupProfile> {
+public:
+  explicit MmkvStartupProfile(std::string instanceId);
+
+  /**
+   Schedules persisting the profile for when the startup window is over, even if no more keys are
+   read after that.
+   */
+  void start();
+
+  /**
+   Records that the given key has been read. Once the startup window is over, this persists the
+   profile (on the background queue) and stops recording.
+   Can be called from any thread.
+   */
+  inline void recordAccess(const std::string& key) {
+    if (!_isRecording) [[likely]] {
+      return;
+    }
+    recordAccessWhileRecording(key);
+  }
+
+  /**
+   Stops recording and persists the profile (on the background queue).
+   */
+  void finish();
+
+  /**
+   Loads the profile of previous launches and returns the keys that are likely to be read again.
+   Must be called from the background queue.
+   */
+  std::vector<std::string> loadPredictedKeys();
+
+private:
+  void recordAccessWhileRecording(const std::string& key);
+  void save();
+  static MMKV* getProfileStorage();
+
+private:
+  std::string _instanceId;
+  std::chrono::steady_clock::time_point _deadline;
+  std::atomic<bool> _isRecording;
+  std::mutex _mutex;
+  std::unordered_set<std::string> _accessedKeys;
+  // Only accessed from the background queue
+  std::unordered_map<std::string, int> _scores;
+};
@@ -0,0 +1,74 @@
+//
+//  MmkvValueCompare.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKV.h"
+#include "MmkvNumbers.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ Checks whether a value is already stored byte for byte (the `compareBeforeSet` config option).
+
+ The stored size is compared first, which rejects most changed values without reading them. Only
+ values of the same encoded size are read and compared.
+ */
+namespace MmkvValueCompare {
+
+inline size_t getVarintSize(uint64_t value) {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    size++;
+  }
+  return size;
+}
+
+inline bool equals(MMKV* mmkv, int64_t value, const std::string& key) {
+  // int64s are stored as plain varints (negative numbers take 10 bytes)
+  if (mmkv->getValueSize(key, false) != getVarintSize(static_cast<uint64_t>(value))) {
+    return false;
+  }
+  return mmkv->getInt64(key, 0) == value;
+}
+
+inline bool equals(MMKV* mmkv, bool value, const std::string& key) {
+  return equals(mmkv, static_cast<int64_t>(value ? 1 : 0), key);
+}
+
+inline bool equals(MMKV* mmkv, double value, const std::string& key, bool compactNumbers) {
+  if (compactNumbers && MmkvNumbers::isVarint(value)) {
+    return equals(mmkv, static_cast<int64_t>(value), key);
+  }
+  if (mmkv->getValueSize(key, false) != MmkvNumbers::kDoubleSize) {
+    return false;
+  }
+  // Compare bits, so NaN equals NaN and 0 does not equal -0
+  double stored = mmkv->getDouble(key, 0.0);
+  return std::memcmp(&stored, &value, sizeof(double)) == 0;
+}
+
+inline bool equals(MMKV* mmkv, const void* data, size_t size, const std::string& key) {
+  // Strings and buffers are stored as a varint length followed by the bytes
+  if (mmkv->getValueSize(key, false) != getVarintSize(size) + size ||
+      mmkv->getValueSize(key, true) != size) {
+    return false;
+  }
+  if (size == 0) {
+    return true;
+  }
+  mmkv::MMBuffer stored = mmkv->getBytes(key);
+  return stored.length() == size && std::memcmp(stored.getPtr(), data, size) == 0;
+}
+
+inline bool equalsBigInt(MMKV* mmkv, int64_t value, const std::string& key) {
+  uint8_t bytes[MmkvNumbers::kBigIntSize];
+  MmkvNumbers::encodeBigInt(value, bytes);
+  return equals(mmkv, bytes, sizeof(bytes), key);
+}
+
+} // namespace MmkvValueCompare
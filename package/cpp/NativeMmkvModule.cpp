@@ -7,8 +7,11 @@
 
 #include "NativeMmkvModule.h"
 #include "MMKV.h"
+#include "MmkvFastBindings.h"
 #include "MmkvHostObject.h"
+#include "MmkvInstance.h"
 #include "MmkvLogger.h"
+#include "MmkvRecovery.h"
 
 namespace facebook::react {
 
@@ -29,15 +32,38 @@ bool NativeMmkvModule::initialize(jsi::Runtime& runtime, std::string basePath) {
 #endif
 
   MMKV::initializeMMKV(basePath, logLevel);
+  MmkvRecovery::install();
+  MmkvFastBindings::install(runtime);
 
   return true;
 }
 
 NativeMmkvModule::~NativeMmkvModule() {}
 
+std::mutex NativeMmkvModule::instancesMutex;
+std::unordered_map<std::string, std::weak_ptr<MmkvHostObject>> NativeMmkvModule::instances;
+
 jsi::Object NativeMmkvModule::createMMKV(jsi::Runtime& runtime, MMKVConfig config) {
-  auto instance = std::make_shared<MmkvHostObject>(config);
+  auto instance = std::make_shared<MmkvHostObject>(config, jsInvoker_);
+  {
+    std::lock_guard<std::mutex> lock(instancesMutex);
+    instances[config.id] = instance;
+  }
   return jsi::Object::createFromHostObject(runtime, instance);
 }
 
+std::shared_ptr<MmkvInstance> NativeMmkvModule::getInstance(const std::string& id) {
+  std::lock_guard<std::mutex> lock(instancesMutex);
+  auto entry = instances.find(id);
+  if (entry == instances.end()) {
+    return nullptr;
+  }
+  std::shared_ptr<MmkvHostObject> hostObject = entry->second.lock();
+  if (hostObject == nullptr) {
+    instances.erase(entry);
+    return nullptr;
+  }
+  return std::make_shared<MmkvInstance>(id, std::move(hostObject));
+}
+
 } // namespace facebook::react
@@ -17,12 +17,23 @@
 #error Cannot find react-native-mmkv spec! Try cleaning your cache and re-running CodeGen!
 #endif
 
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class MmkvHostObject;
+class MmkvInstance;
+
 namespace facebook::react {
 
 // The MMKVConfiguration type from JS
 using MMKVConfig =
     NativeMmkvConfiguration<std::string, std::optional<std::string>, std::optional<std::string>,
-                            std::optional<NativeMmkvMode>, std::optional<bool>>;
+                            std::optional<NativeMmkvMode>, std::optional<bool>,
+                            std::optional<bool>, std::optional<bool>, std::optional<std::string>,
+                            std::optional<std::vector<std::string>>, std::optional<bool>,
+                            std::optional<bool>, std::optional<std::string>, std::optional<bool>>;
 template <> struct Bridging<MMKVConfig> : NativeMmkvConfigurationBridging<MMKVConfig> {};
 
 // The TurboModule itself
@@ -33,6 +44,18 @@ public:
 
   bool initialize(jsi::Runtime& runtime, std::string basePath);
   jsi::Object createMMKV(jsi::Runtime& runtime, MMKVConfig config);
+
+public:
+  /**
+   Returns the instance with the given `id` that was created from JS, or `nullptr` if there is none
+   (yet), for use by other native modules - see MmkvInstance.h.
+   The returned handle keeps the instance open, even after JS garbage-collected it.
+   */
+  static std::shared_ptr<MmkvInstance> getInstance(const std::string& id);
+
+private:
+  static std::mutex instancesMutex;
+  static std::unordered_map<std::string, std::weak_ptr<MmkvHostObject>> instances;
 };
 
 } // namespace facebook::react
@@ -0,0 +1,30 @@
+import type { KeyId } from './Types';
+
+/**
+ * Flat, handle-based bindings for the hottest methods, installed as
+ * `global.__mmkv` when MMKV is initialized.
+ *
+ * Every native instance has a small integer `handle`, which is passed as the
+ * first argument instead of calling a method on the instance's HostObject.
+ */
+export interface FastBindings {
+  set(
+    handle: number,
+    key: string | KeyId,
+    value: boolean | string | number | bigint | ArrayBuffer
+  ): boolean;
+  getBoolean(handle: number, key: string | KeyId): boolean | undefined;
+  getNumber(handle: number, key: string | KeyId): number | undefined;
+  getString(handle: number, key: string | KeyId): string | undefined;
+  contains(handle: number, key: string | KeyId): boolean;
+  delete(handle: number, key: string | KeyId): void;
+}
+
+declare global {
+  // eslint-disable-next-line no-var
+  var __mmkv: FastBindings | undefined;
+}
+
+export function getFastBindings(): FastBindings | undefined {
+  return global.__mmkv;
+}
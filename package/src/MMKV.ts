@@ -1,10 +1,21 @@
 import { createMMKV } from './createMMKV';
 import { createMockMMKV } from './createMMKV.mock';
+import { type FastBindings, getFastBindings } from './FastBindings';
 import { isTest } from './PlatformChecker';
 import type {
+  ChangeSet,
   Configuration,
+  EntriesCursor,
+  EntriesOptions,
+  KeyId,
   Listener,
+  MemoryPressureLevel,
+  MirrorMetrics,
+  MMKVDiff,
+  MMKVFileReference,
   MMKVInterface,
+  MMKVQueue,
+  MMKVRingBuffer,
   NativeMMKV,
 } from './Types';
 import { addMemoryWarningListener } from './MemoryWarningListener';
@@ -18,6 +29,9 @@ export class MMKV implements MMKVInterface {
   private nativeInstance: NativeMMKV;
   private functionCache: Partial<NativeMMKV>;
   private id: string;
+  private registeredKeys: string[];
+  private fastBindings: FastBindings | undefined;
+  private handle: number;
 
   /**
    * Creates a new MMKV instance with the given Configuration.
@@ -29,6 +43,13 @@ export class MMKV implements MMKVInterface {
       ? createMockMMKV()
       : createMMKV(configuration);
     this.functionCache = {};
+    this.registeredKeys = [];
+
+    const handle = (this.nativeInstance as { handle?: number }).handle;
+    const fastBindings =
+      configuration.fastBindings === true ? getFastBindings() : undefined;
+    this.fastBindings = typeof handle === 'number' ? fastBindings : undefined;
+    this.handle = handle ?? -1;
 
     addMemoryWarningListener(this);
   }
@@ -49,6 +70,10 @@ export class MMKV implements MMKVInterface {
     return this.functionCache[functionName] as NativeMMKV[T];
   }
 
+  private getKeyName(key: string | KeyId): string {
+    return typeof key === 'string' ? key : this.registeredKeys[key]!;
+  }
+
   private onValuesChanged(keys: string[]) {
     if (this.onValueChangedListeners.length === 0) return;
 
@@ -62,45 +87,126 @@ export class MMKV implements MMKVInterface {
   get size(): number {
     return this.nativeInstance.size;
   }
+  get mirrorMetrics(): MirrorMetrics | undefined {
+    return this.nativeInstance.mirrorMetrics;
+  }
   get isReadOnly(): boolean {
     return this.nativeInstance.isReadOnly;
   }
-  set(key: string, value: boolean | string | number | ArrayBuffer): void {
-    const func = this.getFunctionFromCache('set');
-    func(key, value);
+  set(
+    key: string | KeyId,
+    value: boolean | string | number | bigint | ArrayBuffer
+  ): boolean {
+    let changed: boolean;
+    if (this.fastBindings != null) {
+      changed = this.fastBindings.set(this.handle, key, value);
+    } else {
+      const func = this.getFunctionFromCache('set');
+      changed = func(key, value);
+    }
+
+    if (changed) this.onValuesChanged([this.getKeyName(key)]);
+    return changed;
+  }
+  concatBuffer(key: string | KeyId, data: ArrayBuffer): void {
+    const func = this.getFunctionFromCache('concatBuffer');
+    func(key, data);
 
-    this.onValuesChanged([key]);
+    this.onValuesChanged([this.getKeyName(key)]);
   }
-  getBoolean(key: string): boolean | undefined {
+  concatString(key: string | KeyId, text: string): void {
+    const func = this.getFunctionFromCache('concatString');
+    func(key, text);
+
+    this.onValuesChanged([this.getKeyName(key)]);
+  }
+  getBoolean(key: string | KeyId): boolean | undefined {
+    if (this.fastBindings != null) {
+      return this.fastBindings.getBoolean(this.handle, key);
+    }
     const func = this.getFunctionFromCache('getBoolean');
     return func(key);
   }
-  getString(key: string): string | undefined {
+  getString(key: string | KeyId): string | undefined {
+    if (this.fastBindings != null) {
+      return this.fastBindings.getString(this.handle, key);
+    }
     const func = this.getFunctionFromCache('getString');
     return func(key);
   }
-  getNumber(key: string): number | undefined {
+  getNumber(key: string | KeyId): number | undefined {
+    if (this.fastBindings != null) {
+      return this.fastBindings.getNumber(this.handle, key);
+    }
     const func = this.getFunctionFromCache('getNumber');
     return func(key);
   }
-  getBuffer(key: string): ArrayBuffer | undefined {
+  getBigInt(key: string | KeyId): bigint | undefined {
+    const func = this.getFunctionFromCache('getBigInt');
+    return func(key);
+  }
+  getBuffer(key: string | KeyId): ArrayBuffer | undefined {
     const func = this.getFunctionFromCache('getBuffer');
     return func(key);
   }
-  contains(key: string): boolean {
+  getBufferRange(
+    key: string | KeyId,
+    offset: number,
+    length: number
+  ): ArrayBuffer | undefined {
+    const func = this.getFunctionFromCache('getBufferRange');
+    return func(key, offset, length);
+  }
+  getValueSize(key: string | KeyId): number | undefined {
+    const func = this.getFunctionFromCache('getValueSize');
+    return func(key);
+  }
+  contains(key: string | KeyId): boolean {
+    if (this.fastBindings != null) {
+      return this.fastBindings.contains(this.handle, key);
+    }
     const func = this.getFunctionFromCache('contains');
     return func(key);
   }
-  delete(key: string): void {
-    const func = this.getFunctionFromCache('delete');
-    func(key);
+  delete(key: string | KeyId): void {
+    if (this.fastBindings != null) {
+      this.fastBindings.delete(this.handle, key);
+    } else {
+      const func = this.getFunctionFromCache('delete');
+      func(key);
+    }
 
-    this.onValuesChanged([key]);
+    this.onValuesChanged([this.getKeyName(key)]);
+  }
+  registerKeys(keys: string[]): KeyId[] {
+    const func = this.getFunctionFromCache('registerKeys');
+    const keyIds = func(keys);
+    // Listeners are always called with the key itself, not its KeyId.
+    keyIds.forEach((keyId, index) => {
+      this.registeredKeys[keyId] = keys[index]!;
+    });
+    return keyIds;
   }
   getAllKeys(): string[] {
     const func = this.getFunctionFromCache('getAllKeys');
     return func();
   }
+  diff(other: NativeMMKV | MMKVFileReference): MMKVDiff {
+    const func = this.getFunctionFromCache('diff');
+    return func(other instanceof MMKV ? other.nativeInstance : other);
+  }
+  entries(options?: EntriesOptions): EntriesCursor {
+    const func = this.getFunctionFromCache('entries');
+    return func(options);
+  }
+  queue(name: string): MMKVQueue {
+    const func = this.getFunctionFromCache('queue');
+    return func(name);
+  }
+  ringBuffer(name: string, capacity: number): MMKVRingBuffer {
+    const func = this.getFunctionFromCache('ringBuffer');
+    return func(name, capacity);
+  }
   clearAll(): void {
     const keys = this.getAllKeys();
 
@@ -113,10 +219,30 @@ export class MMKV implements MMKVInterface {
     const func = this.getFunctionFromCache('recrypt');
     return func(key);
   }
+  changesSince(sequence: number, limit?: number): ChangeSet {
+    const func = this.getFunctionFromCache('changesSince');
+    return func(sequence, limit);
+  }
+  truncateChangesBefore(sequence: number): number {
+    const func = this.getFunctionFromCache('truncateChangesBefore');
+    return func(sequence);
+  }
   trim(): void {
     const func = this.getFunctionFromCache('trim');
     func();
   }
+  flush(): Promise<void> {
+    const func = this.getFunctionFromCache('flush');
+    return func();
+  }
+  handleMemoryPressure(level: MemoryPressureLevel): void {
+    const func = this.getFunctionFromCache('handleMemoryPressure');
+    func(level);
+  }
+  prefetch(keysOrPrefix: string[] | string): void {
+    const func = this.getFunctionFromCache('prefetch');
+    func(keysOrPrefix);
+  }
 
   toString(): string {
     return `MMKV (${this.id}): [${this.getAllKeys().join(', ')}]`;
@@ -1,14 +1,19 @@
 import { AppState } from 'react-native';
 import type { NativeEventSubscription } from 'react-native';
-import { MMKVInterface } from './Types';
+import { MemoryPressureLevel, MMKVInterface } from './Types';
+
+function getMemoryPressureLevel(): MemoryPressureLevel {
+  // Backgrounded apps are the first ones to be killed, so free everything we can there.
+  return AppState.currentState === 'active' ? 'moderate' : 'critical';
+}
 
 export function addMemoryWarningListener(mmkv: MMKVInterface): void {
   if (global.WeakRef != null && global.FinalizationRegistry != null) {
     // 1. Weakify MMKV so we can safely use it inside the memoryWarning event listener
     const weakMmkv = new WeakRef(mmkv);
     const listener = AppState.addEventListener('memoryWarning', () => {
-      // 0. Everytime we receive a memoryWarning, we try to trim the MMKV instance (if it is still valid)
-      weakMmkv.deref()?.trim();
+      // 0. Everytime we receive a memoryWarning, we release memory of the MMKV instance (if it is still valid)
+      weakMmkv.deref()?.handleMemoryPressure(getMemoryPressureLevel());
     });
     // 2. Add a listener to when the MMKV instance is deleted
     const finalization = new FinalizationRegistry(
@@ -23,7 +28,7 @@ export function addMemoryWarningListener(mmkv: MMKVInterface): void {
     // WeakRef/FinalizationRegistry is not implemented in this engine.
     // Just add the listener, even if it retains MMKV strong forever.
     AppState.addEventListener('memoryWarning', () => {
-      mmkv.trim();
+      mmkv.handleMemoryPressure(getMemoryPressureLevel());
     });
   }
 }
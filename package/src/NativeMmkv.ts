@@ -79,6 +79,101 @@ export interface Configuration {
    * If `true`, the MMKV instance can only read from the storage, but not write to it.
    */
   readOnly?: boolean;
+  /**
+   * If `true`, MMKV records which keys are read during the first seconds after this instance
+   * is created, and on the next launches prefetches those values on a background thread
+   * before JS asks for them.
+   *
+   * @default false
+   */
+  startupWarmup?: boolean;
+  /**
+   * If `true`, a corrupted instance (e.g. because the app was killed while MMKV was rewriting
+   * the file) keeps every record that is still valid, and only the corrupted tail is dropped.
+   *
+   * By default, MMKV clears a corrupted instance. Recovering still decodes the file from the
+   * start, so it is not faster than that. MMKV's file format only has a checksum for the whole
+   * file, not per record, so a corrupted record in the middle also drops every record after it.
+   *
+   * @default false
+   */
+  recoverOnCorruption?: boolean;
+  /**
+   * A directory containing a read-only base file with the same `id`, e.g. one shipped in the
+   * app bundle.
+   *
+   * The base file is mapped read-only and never copied. This instance becomes a writable overlay
+   * on top of it: reads return the overlay's value if there is one, and the base file's value
+   * otherwise. Deleting a key that only exists in the base file stores a tombstone, so it stays
+   * deleted.
+   *
+   * The base file has to be encrypted with the same `encryptionKey` as this instance.
+   *
+   * @example
+   * ```ts
+   * const settings = new MMKV({ id: 'settings', overlayBasePath: `${bundlePath}/defaults` })
+   * ```
+   */
+  overlayBasePath?: string;
+  /**
+   * Shared key prefixes to store only once.
+   *
+   * Keys that start with one of these prefixes are stored as a 2-byte reference to the prefix plus
+   * the rest of the key, which shrinks the file (and the memory, CRC and load work that scales with
+   * it) for long, repetitive keys like `feature.onboarding.step.3.completed`.
+   * Existing keys are re-encoded once when the list changes - only ever append to it, reordering
+   * or removing prefixes re-encodes every key. Keys cannot start with the `\x01` character.
+   *
+   * @example
+   * ```ts
+   * const storage = new MMKV({ id: 'features', keyPrefixes: ['feature.onboarding.step.'] })
+   * ```
+   */
+  keyPrefixes?: string[];
+  /**
+   * If `true`, `set(..)` first checks whether the key already holds
+   * exactly the same value, and if so, skips the write and does not notify value listeners.
+   *
+   * Every write appends a record to the file, even if the value did not change, so this slows
+   * down file growth (and compaction) for code that keeps setting the same values, e.g. state
+   * persistence middlewares. The check compares the stored size first and only reads values of
+   * the same size.
+   *
+   * @default false
+   */
+  compareBeforeSet?: boolean;
+  /**
+   * If `true`, every write and delete gets a sequence number, and the instance keeps a log of the
+   * latest change of every key - see `changesSince(..)`.
+   *
+   * The log is stored next to the instance and holds one small record per key that was ever
+   * written, so it does not grow with the number of writes. Deleted keys keep their record until
+   * the log is truncated with `truncateChangesBefore(..)`. It cannot be used in `MULTI_PROCESS`
+   * mode.
+   *
+   * @default false
+   */
+  changeLog?: boolean;
+  /**
+   * A directory to keep a mirror of this instance in, e.g. a backup directory or an App Group
+   * container.
+   *
+   * The mirror has the same `id` and `encryptionKey`, and is kept up to date on a background
+   * thread by copying only the keys that changed (using a change log, see `changeLog`). It is
+   * synced to disk after every pass, so it stays consistent even if the app crashes. For overlays
+   * (`overlayBasePath`), only the local changes are mirrored.
+   */
+  mirrorPath?: string;
+  /**
+   * If `true`, integral numbers from 0 to 2^49 (counters, IDs, timestamps) are stored as compact
+   * 1-7 byte integers instead of 8-byte doubles.
+   *
+   * Only enable this for instances that are never read by MMKV's native SDKs (`decodeDouble`) or
+   * by versions of this library that do not support it - they read such numbers wrongly.
+   *
+   * @default false
+   */
+  compactNumbers?: boolean;
 }
 
 export interface Spec extends TurboModule {
@@ -70,8 +70,307 @@ export interface Configuration {
    * @default SINGLE_PROCESS
    */
   mode?: Mode;
+  /**
+   * If `true`, MMKV records which keys are read during the first seconds after this instance
+   * is created, and on the next launches prefetches those values on a background thread
+   * before JS asks for them.
+   *
+   * @default false
+   */
+  startupWarmup?: boolean;
+  /**
+   * If `true`, a corrupted instance (e.g. because the app was killed while MMKV was rewriting
+   * the file) keeps every record that is still valid, and only the corrupted tail is dropped.
+   *
+   * By default, MMKV clears a corrupted instance. Recovering still decodes the file from the
+   * start, so it is not faster than that. MMKV's file format only has a checksum for the whole
+   * file, not per record, so a corrupted record in the middle also drops every record after it.
+   *
+   * @default false
+   */
+  recoverOnCorruption?: boolean;
+  /**
+   * A directory containing a read-only base file with the same `id`, e.g. one shipped in the
+   * app bundle.
+   *
+   * The base file is mapped read-only and never copied. This instance becomes a writable overlay
+   * on top of it: reads return the overlay's value if there is one, and the base file's value
+   * otherwise. Deleting a key that only exists in the base file stores a tombstone, so it stays
+   * deleted.
+   *
+   * The base file has to be encrypted with the same `encryptionKey` as this instance.
+   *
+   * @example
+   * ```ts
+   * const settings = new MMKV({ id: 'settings', overlayBasePath: `${bundlePath}/defaults` })
+   * ```
+   */
+  overlayBasePath?: string;
+  /**
+   * Shared key prefixes to store only once.
+   *
+   * Keys that start with one of these prefixes are stored as a 2-byte reference to the prefix plus
+   * the rest of the key, which shrinks the file (and the memory, CRC and load work that scales with
+   * it) for long, repetitive keys like `feature.onboarding.step.3.completed`.
+   * Existing keys are re-encoded once when the list changes - only ever append to it, reordering
+   * or removing prefixes re-encodes every key. Keys cannot start with the `\x01` character.
+   *
+   * @example
+   * ```ts
+   * const storage = new MMKV({ id: 'features', keyPrefixes: ['feature.onboarding.step.'] })
+   * ```
+   */
+  keyPrefixes?: string[];
+  /**
+   * If `true`, {@linkcode NativeMMKV.set | set(..)} first checks whether the key already holds
+   * exactly the same value, and if so, skips the write and does not notify value listeners.
+   *
+   * Every write appends a record to the file, even if the value did not change, so this slows
+   * down file growth (and compaction) for code that keeps setting the same values, e.g. state
+   * persistence middlewares. The check compares the stored size first and only reads values of
+   * the same size.
+   *
+   * @default false
+   */
+  compareBeforeSet?: boolean;
+  /**
+   * If `true`, `set`, `getBoolean`, `getNumber`, `getString`, `contains` and `delete` are called
+   * through the flat, handle-based functions in `global.__mmkv` instead of through the instance's
+   * HostObject.
+   *
+   * This skips the HostObject's property lookup, and lets the JS engine cache the functions in hot
+   * loops. It has no effect on Web and in tests.
+   *
+   * @default false
+   */
+  fastBindings?: boolean;
+  /**
+   * If `true`, every write and delete gets a sequence number, and the instance keeps a log of the
+   * latest change of every key - see {@linkcode NativeMMKV.changesSince | changesSince(..)}.
+   *
+   * The log is stored next to the instance and holds one small record per key that was ever
+   * written, so it does not grow with the number of writes. Deleted keys keep their record until
+   * the log is truncated with
+   * {@linkcode NativeMMKV.truncateChangesBefore | truncateChangesBefore(..)}. It cannot be used in
+   * `MULTI_PROCESS` mode.
+   *
+   * @default false
+   */
+  changeLog?: boolean;
+  /**
+   * A directory to keep a mirror of this instance in, e.g. a backup directory or an App Group
+   * container.
+   *
+   * The mirror has the same `id` and `encryptionKey`, and is kept up to date on a background
+   * thread by copying only the keys that changed (using a change log, see
+   * {@linkcode changeLog}). It is synced to disk after every pass, so it stays consistent even if
+   * the app crashes. For overlays (`overlayBasePath`), only the local changes are mirrored.
+   */
+  mirrorPath?: string;
+  /**
+   * If `true`, integral numbers from 0 to 2^49 (counters, IDs, timestamps) are stored as compact
+   * 1-7 byte integers instead of 8-byte doubles.
+   *
+   * Only enable this for instances that are never read by MMKV's native SDKs (`decodeDouble`) or
+   * by versions of this library that do not support it - they read such numbers wrongly.
+   *
+   * @default false
+   */
+  compactNumbers?: boolean;
+}
+
+/**
+ * The type values are decoded as when reading entries in bulk.
+ */
+export type ValueType = 'string' | 'number' | 'boolean' | 'buffer';
+
+/**
+ * Options for {@linkcode NativeMMKV.entries}.
+ */
+export interface EntriesOptions {
+  /**
+   * Only read entries whose key starts with this prefix.
+   *
+   * @default ''
+   */
+  prefix?: string;
+  /**
+   * The number of entries each call to `next()` returns, an integer between 1 and 2^31 - 1.
+   *
+   * @default 100
+   */
+  chunkSize?: number;
+  /**
+   * The type all values are decoded as. MMKV does not store types, so entries
+   * whose value cannot be decoded as this type are skipped.
+   *
+   * @default 'string'
+   */
+  type?: ValueType;
+}
+
+/**
+ * Reads the entries of an MMKV instance in chunks.
+ */
+export interface EntriesCursor {
+  /**
+   * Get the next chunk of `[key, value]` pairs, or `undefined` if all entries have been read.
+   */
+  next(): [key: string, value: boolean | string | number | ArrayBuffer][] | undefined;
+}
+
+/**
+ * A persistent first-in-first-out queue of strings, see {@linkcode NativeMMKV.queue}.
+ */
+export interface MMKVQueue {
+  /**
+   * Appends the given items to the end of the queue.
+   *
+   * @throws an Error if the items cannot be stored.
+   */
+  push(items: string[]): void;
+  /**
+   * Get (up to) `count` items from the front of the queue, without removing them.
+   */
+  peek(count: number): string[];
+  /**
+   * Removes (up to) `count` items from the front of the queue and returns them.
+   */
+  pop(count: number): string[];
+  /**
+   * The number of items in the queue.
+   */
+  readonly size: number;
+}
+
+/**
+ * A fixed-capacity persistent ring buffer of numbers, see {@linkcode NativeMMKV.ringBuffer}.
+ */
+export interface MMKVRingBuffer {
+  /**
+   * Appends the given sample(s), overwriting the oldest samples once the ring buffer is full.
+   */
+  push(values: number | number[]): void;
+  /**
+   * Get (up to) the last `count` samples, oldest first.
+   *
+   * @throws an Error if `count` is not a non-negative integer.
+   */
+  last(count: number): Float64Array;
+  /**
+   * The number of samples in the ring buffer (at most {@linkcode capacity}).
+   */
+  readonly size: number;
+  /**
+   * The maximum number of samples the ring buffer holds.
+   */
+  readonly capacity: number;
+}
+
+/**
+ * An MMKV file that is not open as an instance, e.g. a freshly downloaded
+ * reference store. See {@linkcode NativeMMKV.diff}.
+ */
+export interface MMKVFileReference {
+  /**
+   * The file's MMKV instance ID.
+   */
+  id: string;
+  /**
+   * The directory containing the file.
+   */
+  path: string;
+  /**
+   * The file's encryption key, if it is encrypted.
+   */
+  encryptionKey?: string;
+  /**
+   * The file's `keyPrefixes`, if it was written with them.
+   */
+  keyPrefixes?: string[];
 }
 
+/**
+ * The differences between two instances, see {@linkcode NativeMMKV.diff}.
+ */
+export interface MMKVDiff {
+  /**
+   * Keys that only exist in the other instance.
+   */
+  added: string[];
+  /**
+   * Keys that only exist in this instance.
+   */
+  removed: string[];
+  /**
+   * Keys that exist in both instances, but with different values.
+   */
+  changed: string[];
+}
+
+/**
+ * How far a mirror is behind its instance, see {@linkcode NativeMMKV.mirrorMetrics}.
+ */
+export interface MirrorMetrics {
+  /**
+   * The last sequence number that was replicated to the mirror.
+   */
+  sequence: number;
+  /**
+   * The number of changes that have not been replicated yet.
+   */
+  lag: number;
+  /**
+   * How long the oldest change that has not been replicated yet has been waiting, in milliseconds.
+   */
+  lagMs: number;
+  /**
+   * The number of changes (and bytes) replicated since the instance was opened.
+   */
+  replicatedChanges: number;
+  replicatedBytes: number;
+  /**
+   * The replication throughput, measured over the time spent replicating.
+   */
+  changesPerSecond: number;
+  bytesPerSecond: number;
+}
+
+/**
+ * A page of changes, see {@linkcode NativeMMKV.changesSince}.
+ */
+export interface ChangeSet {
+  /**
+   * The keys that were set since the given sequence number.
+   */
+  changed: string[];
+  /**
+   * The keys that were deleted since the given sequence number.
+   */
+  deleted: string[];
+  /**
+   * The sequence number to pass to the next {@linkcode NativeMMKV.changesSince} call.
+   */
+  sequence: number;
+  /**
+   * Whether there are more changes after this page.
+   */
+  hasMore: boolean;
+}
+
+/**
+ * How severe a memory warning is. See {@linkcode NativeMMKV.handleMemoryPressure}.
+ */
+export type MemoryPressureLevel = 'moderate' | 'critical';
+
+/**
+ * A compact ID for a key registered with {@linkcode NativeMMKV.registerKeys}.
+ *
+ * Accessing a value by its `KeyId` looks the key up in a native table instead of
+ * converting a JS string on every call.
+ */
+export type KeyId = number & { readonly __mmkvKeyId: unique symbol };
+
 /**
  * Represents a single MMKV instance.
  */
@@ -79,47 +378,208 @@ export interface NativeMMKV {
   /**
    * Set a value for the given `key`.
    *
-   * @throws an Error if the value cannot be set.
+   * Numbers are stored as 8-byte doubles (see
+   * {@linkcode Configuration.compactNumbers | compactNumbers}). BigInts are stored exactly as
+   * 64-bit integers - read them with {@linkcode getBigInt}.
+   *
+   * A single string or buffer value can be at most 2 GB (2^31 - 1 bytes) large, because
+   * MMKV's file format stores value lengths as 32-bit integers.
+   *
+   * @returns `false` if the write was skipped because the value did not change (only with
+   * {@linkcode Configuration.compareBeforeSet | compareBeforeSet}), `true` otherwise.
+   * @throws an Error if the value cannot be set, or is larger than 2 GB.
+   */
+  set: (
+    key: string | KeyId,
+    value: boolean | string | number | bigint | ArrayBuffer
+  ) => boolean;
+  /**
+   * Replaces the buffer stored for the given `key` with that buffer followed by
+   * `data` (or stores `data` if there is no value yet).
+   *
+   * This is a read-modify-write convenience, not an append: the existing value is
+   * read and the whole combined value is written again, natively. Each call costs
+   * O(size of the value), so building up a value with many calls costs O(n²). To
+   * keep a growing log, store its entries under separate keys (or use
+   * {@linkcode queue}) instead.
+   *
+   * @throws an Error if the value cannot be set, or would become larger than 2 GB
+   * (see {@linkcode set}).
+   */
+  concatBuffer: (key: string | KeyId, data: ArrayBuffer) => void;
+  /**
+   * Replaces the string stored for the given `key` with that string followed by
+   * `text` (or stores `text` if there is no value yet).
+   *
+   * Like {@linkcode concatBuffer}, this reads and rewrites the whole value.
+   *
+   * @throws an Error if the value cannot be set, or would become larger than 2 GB
+   * (see {@linkcode set}).
    */
-  set: (key: string, value: boolean | string | number | ArrayBuffer) => void;
+  concatString: (key: string | KeyId, text: string) => void;
   /**
    * Get the boolean value for the given `key`, or `undefined` if it does not exist.
    *
    * @default undefined
    */
-  getBoolean: (key: string) => boolean | undefined;
+  getBoolean: (key: string | KeyId) => boolean | undefined;
   /**
    * Get the string value for the given `key`, or `undefined` if it does not exist.
    *
    * @default undefined
    */
-  getString: (key: string) => string | undefined;
+  getString: (key: string | KeyId) => string | undefined;
   /**
    * Get the number value for the given `key`, or `undefined` if it does not exist.
    *
    * @default undefined
    */
-  getNumber: (key: string) => number | undefined;
+  getNumber: (key: string | KeyId) => number | undefined;
+  /**
+   * Get the 64-bit integer value for the given `key` as a BigInt, or `undefined` if it does not exist.
+   *
+   * Reads values stored as BigInts, and numbers that are integers in the 64-bit range.
+   * MMKV does not store types, so an 8-byte string or buffer is read as a BigInt as well.
+   *
+   * @default undefined
+   */
+  getBigInt: (key: string | KeyId) => bigint | undefined;
   /**
    * Get a raw buffer of unsigned 8-bit (0-255) data.
    *
    * @default undefined
    */
-  getBuffer: (key: string) => ArrayBuffer | undefined;
+  getBuffer: (key: string | KeyId) => ArrayBuffer | undefined;
+  /**
+   * Get a window of `length` bytes, starting at `offset`, of the raw buffer stored for the given `key`,
+   * or `undefined` if it does not exist.
+   *
+   * Only the window is handed to JS, but MMKV cannot read part of a value: the whole value is
+   * still read (and decrypted) natively on every call, so each call costs as much as
+   * {@linkcode getBuffer} on the native side. To read a large value piece by piece, store the
+   * pieces under separate keys instead.
+   *
+   * Stored values are at most 2 GB large (see {@linkcode set}), so `offset + length` never
+   * exceeds 2^31 - 1.
+   *
+   * @throws an Error if `offset` and `length` are not non-negative integers, or the window
+   * does not fit into the stored buffer (see {@linkcode getValueSize}).
+   *
+   * @default undefined
+   */
+  getBufferRange: (
+    key: string | KeyId,
+    offset: number,
+    length: number
+  ) => ArrayBuffer | undefined;
+  /**
+   * Get the size of the value stored for the given `key` in bytes, without reading the value itself,
+   * or `undefined` if it does not exist.
+   *
+   * For strings this is the size of the UTF-8 encoded string, for buffers the size of the buffer.
+   *
+   * @default undefined
+   */
+  getValueSize: (key: string | KeyId) => number | undefined;
   /**
    * Checks whether the given `key` is being stored in this MMKV instance.
    */
-  contains: (key: string) => boolean;
+  contains: (key: string | KeyId) => boolean;
   /**
    * Delete the given `key`.
    */
-  delete: (key: string) => void;
+  delete: (key: string | KeyId) => void;
+  /**
+   * Registers the given keys and returns a {@linkcode KeyId} for each of them, in the same order.
+   *
+   * All functions that take a `key` also accept a `KeyId` instead, which skips converting the key
+   * from a JS string (and encoding it with `keyPrefixes`) on every call.
+   * Registering a key again returns the same `KeyId`. KeyIds are only valid for this instance.
+   *
+   * See {@linkcode defineKeys} for a typed wrapper.
+   */
+  registerKeys: (keys: string[]) => KeyId[];
   /**
    * Get all keys.
    *
    * @default []
    */
   getAllKeys: () => string[];
+  /**
+   * Compares this instance with another instance (or an MMKV file that is not open), and returns
+   * which keys would have to be added, removed or changed to turn this instance into the other one.
+   *
+   * The comparison runs natively, in one call, and only reads values whose stored size is the same
+   * in both instances. Each key list is sorted.
+   *
+   * A file reference is opened read-only for the comparison, and closed again afterwards unless an
+   * instance already has it open. A reference to this instance's own file has no differences.
+   *
+   * @example
+   * ```ts
+   * const { added, removed, changed } = storage.diff({ id: 'reference', path: downloadDirectory })
+   * ```
+   */
+  diff: (other: NativeMMKV | MMKVFileReference) => MMKVDiff;
+  /**
+   * Get a cursor over all entries (or all entries whose key starts with `prefix`).
+   *
+   * Each call to `next()` decodes a whole chunk of values natively, which is a lot
+   * faster than calling `getAllKeys()` and then a getter for each key.
+   *
+   * Keys are snapshotted when the cursor is created, and keys that are deleted
+   * afterwards are skipped. Values are read when their chunk is read.
+   *
+   * @example
+   * ```ts
+   * const cursor = storage.entries({ prefix: 'user.', type: 'string' })
+   * for (let chunk = cursor.next(); chunk != null; chunk = cursor.next()) {
+   *   for (const [key, value] of chunk) {
+   *     console.log(key, value)
+   *   }
+   * }
+   * ```
+   */
+  entries: (options?: EntriesOptions) => EntriesCursor;
+  /**
+   * Get the persistent queue with the given `name`.
+   *
+   * Queues are stored next to this instance (with the same path, mode and encryption key),
+   * but not inside of it - their items do not show up in `getAllKeys()`.
+   * Pushing and popping costs O(1) per item, no matter how long the queue is.
+   *
+   * @example
+   * ```ts
+   * const events = storage.queue('analytics')
+   * events.push([JSON.stringify(event)])
+   * const batch = events.peek(100)
+   * await upload(batch)
+   * events.pop(batch.length)
+   * ```
+   */
+  queue: (name: string) => MMKVQueue;
+  /**
+   * Get the persistent ring buffer with the given `name`, holding the last `capacity` numbers.
+   *
+   * Ring buffers are preallocated files next to this instance, and samples are overwritten in
+   * place - so pushing a sample is O(1) and never grows the file, which makes them a good fit for
+   * high-frequency telemetry (FPS, memory usage, latencies, ...).
+   * Ring buffers are not encrypted, and must not be written to from multiple processes.
+   *
+   * Samples are written to a shared memory mapping of the file, which the OS writes back on its
+   * own - they survive the app crashing or being killed, but the last samples can be lost if the
+   * device loses power. {@linkcode flush} does not sync ring buffers.
+   *
+   * @throws an Error if a ring buffer with this `name` already exists with a different `capacity`.
+   *
+   * @example
+   * ```ts
+   * const fps = storage.ringBuffer('fps', 600)
+   * fps.push(currentFps)
+   * const lastMinute = fps.last(60)
+   * ```
+   */
+  ringBuffer: (name: string, capacity: number) => MMKVRingBuffer;
   /**
    * Delete all keys.
    */
@@ -134,6 +594,40 @@ export interface NativeMMKV {
    * @throws an Error if the instance cannot be recrypted.
    */
   recrypt: (key: string | undefined) => void;
+  /**
+   * Get the keys that changed after the given sequence number, oldest first, in pages of at most
+   * `limit` keys (default: 1000).
+   *
+   * Each key is only returned once, with its latest change. Store the returned `sequence` and pass
+   * it to the next call (start with `0`) to get only what changed since then - e.g. for syncing a
+   * store incrementally instead of diffing all of it.
+   *
+   * @throws an Error if the instance was not created with `changeLog: true`.
+   *
+   * @example
+   * ```ts
+   * let page: ChangeSet
+   * do {
+   *   page = storage.changesSince(lastSyncedSequence)
+   *   await upload(page.changed, page.deleted)
+   *   lastSyncedSequence = page.sequence
+   * } while (page.hasMore)
+   * ```
+   */
+  changesSince: (sequence: number, limit?: number) => ChangeSet;
+  /**
+   * Removes the changes up to and including `sequence` from the change log, e.g. once every reader
+   * has synced past it. The log keeps one record per key that was ever written (including deleted
+   * keys), so call this periodically if many different keys come and go.
+   *
+   * Readers that call {@linkcode changesSince} with a sequence number before `sequence` miss the
+   * removed changes, so they have to sync everything again. The latest change is always kept, and
+   * changes a `mirrorPath` mirror has not replicated yet are never removed.
+   *
+   * @returns the number of changes that were removed.
+   * @throws an Error if the instance was not created with `changeLog: true`.
+   */
+  truncateChangesBefore: (sequence: number) => number;
   /**
    * Trims the storage space and clears memory cache.
    *
@@ -144,10 +638,51 @@ export interface NativeMMKV {
    * In most applications, this is not needed at all.
    */
   trim(): void;
+  /**
+   * Writes all pending changes of this instance to disk on a background thread.
+   *
+   * MMKV writes into a memory-mapped file, so changes survive app crashes anyway -
+   * use this if they also have to survive power loss or OS crashes.
+   *
+   * @returns a Promise that resolves once the data has been flushed, or rejects if it could not be
+   * flushed.
+   */
+  flush(): Promise<void>;
+  /**
+   * Releases memory held by this instance on a background thread, depending on the given level:
+   * - `moderate`: Drops the in-memory caches of large instances.
+   * - `critical`: Also shrinks the file if most of it is unused, and releases its page-cache pages.
+   *
+   * This is automatically called when the app receives a memory warning.
+   */
+  handleMemoryPressure(level: MemoryPressureLevel): void;
+  /**
+   * Warms up the pages of the given keys (or of all keys starting with the given prefix)
+   * on a background thread, so that subsequent reads do not have to wait for the disk.
+   * With {@linkcode Configuration.overlayBasePath | overlayBasePath}, the same keys are also
+   * warmed up in the base file.
+   *
+   * Use this ahead of time when you know which values an upcoming screen is going to read.
+   *
+   * @example
+   * ```ts
+   * storage.prefetch(['user.name', 'user.avatar'])
+   * storage.prefetch('feed.')
+   * ```
+   */
+  prefetch(keysOrPrefix: string[] | string): void;
   /**
    * Get the current total size of the storage, in bytes.
+   *
+   * Reported exactly up to 2^53 bytes. The number of values is not limited, but each single
+   * value is (see {@linkcode set}).
    */
   readonly size: number;
+  /**
+   * How far the mirror (see {@linkcode Configuration.mirrorPath | mirrorPath}) is behind this
+   * instance, or `undefined` if this instance has no mirror.
+   */
+  readonly mirrorMetrics: MirrorMetrics | undefined;
   /**
    * Returns whether this instance is in read-only mode or not.
    * If this is `true`, you can only use "get"-functions.
@@ -0,0 +1,69 @@
+import { MMKV } from '..';
+
+const mmkv = new MMKV({ id: 'change-log', changeLog: true });
+
+// The sequence number after all changes of the previous tests.
+const getLatestSequence = () => {
+  let sequence = 0;
+  let hasMore = true;
+  while (hasMore) {
+    ({ sequence, hasMore } = mmkv.changesSince(sequence));
+  }
+  return sequence;
+};
+
+test('changesSince() returns each key once, with its latest change', () => {
+  const start = getLatestSequence();
+  mmkv.set('a', 1);
+  mmkv.set('b', 2);
+  mmkv.set('a', 3);
+  mmkv.delete('b');
+
+  const page = mmkv.changesSince(start);
+  expect(page.changed).toEqual(['a']);
+  expect(page.deleted).toEqual(['b']);
+  expect(page.hasMore).toBe(false);
+  expect(page.sequence).toBeGreaterThan(start);
+
+  const next = mmkv.changesSince(page.sequence);
+  expect(next.changed).toEqual([]);
+  expect(next.deleted).toEqual([]);
+  expect(next.sequence).toBe(page.sequence);
+});
+
+test('changesSince() returns the changes in pages, oldest first', () => {
+  const start = getLatestSequence();
+  ['k1', 'k2', 'k3', 'k4', 'k5'].forEach((key) => mmkv.set(key, key));
+
+  const first = mmkv.changesSince(start, 2);
+  expect(first.changed).toEqual(['k1', 'k2']);
+  expect(first.hasMore).toBe(true);
+  const second = mmkv.changesSince(first.sequence, 2);
+  expect(second.changed).toEqual(['k3', 'k4']);
+  expect(second.hasMore).toBe(true);
+  const third = mmkv.changesSince(second.sequence, 2);
+  expect(third.changed).toEqual(['k5']);
+  expect(third.hasMore).toBe(false);
+});
+
+test('clearAll() is logged as a delete of every key', () => {
+  mmkv.set('x', true);
+  mmkv.set('y', false);
+  const start = getLatestSequence();
+  mmkv.clearAll();
+
+  const page = mmkv.changesSince(start);
+  expect(page.changed).toEqual([]);
+  expect(page.deleted).toEqual(expect.arrayContaining(['x', 'y']));
+});
+
+test('truncateChangesBefore() removes the changes readers have seen', () => {
+  const start = getLatestSequence();
+  ['t1', 't2', 't3'].forEach((key) => mmkv.set(key, key));
+  const { sequence } = mmkv.changesSince(start, 2);
+
+  expect(mmkv.truncateChangesBefore(sequence)).toBeGreaterThanOrEqual(2);
+  expect(mmkv.changesSince(0).changed).toEqual(['t3']);
+  // The latest change is always kept
+  expect(mmkv.truncateChangesBefore(getLatestSequence())).toBe(0);
+});
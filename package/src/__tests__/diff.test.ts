@@ -0,0 +1,58 @@
+import { MMKV } from '..';
+
+const mmkv = new MMKV({ id: 'diff-from' });
+const other = new MMKV({ id: 'diff-to' });
+
+beforeEach(() => {
+  mmkv.clearAll();
+  other.clearAll();
+});
+
+test('diff() returns the added, removed and changed keys, sorted', () => {
+  mmkv.set('same', 'value');
+  mmkv.set('removed', 1);
+  mmkv.set('changed.b', 'old');
+  mmkv.set('changed.a', true);
+  other.set('same', 'value');
+  other.set('added', 2);
+  other.set('changed.b', 'new');
+  other.set('changed.a', false);
+
+  expect(mmkv.diff(other)).toEqual({
+    added: ['added'],
+    removed: ['removed'],
+    changed: ['changed.a', 'changed.b'],
+  });
+});
+
+test('diff() compares values of every type', () => {
+  const values = [
+    'text',
+    42,
+    2n ** 60n,
+    true,
+    new Uint8Array([1, 2, 3]).buffer,
+  ] as const;
+  values.forEach((value, index) => {
+    mmkv.set(`key${index}`, value);
+    other.set(`key${index}`, value);
+  });
+  expect(mmkv.diff(other).changed).toEqual([]);
+
+  other.set('key4', new Uint8Array([1, 2, 4]).buffer);
+  other.set('key2', 2n ** 60n + 1n);
+  expect(mmkv.diff(other).changed).toEqual(['key2', 'key4']);
+});
+
+test('diff() treats a value of a different type as changed', () => {
+  mmkv.set('key', '1');
+  other.set('key', 1);
+
+  expect(mmkv.diff(other).changed).toEqual(['key']);
+});
+
+test('diff() of an instance with itself is empty', () => {
+  mmkv.set('key', 'value');
+
+  expect(mmkv.diff(mmkv)).toEqual({ added: [], removed: [], changed: [] });
+});
@@ -0,0 +1,63 @@
+import { MMKV, type EntriesCursor } from '..';
+
+const mmkv = new MMKV();
+
+beforeEach(() => {
+  mmkv.clearAll();
+});
+
+const byKey = ([a]: [string, unknown], [b]: [string, unknown]) =>
+  a.localeCompare(b);
+
+const readAll = (cursor: EntriesCursor) => {
+  const entries: [string, unknown][] = [];
+  for (let chunk = cursor.next(); chunk != null; chunk = cursor.next()) {
+    entries.push(...chunk);
+  }
+  return entries.sort(byKey);
+};
+
+test('entries() returns the entries with the given prefix in chunks', () => {
+  mmkv.set('user.name', 'Marc');
+  mmkv.set('user.city', 'Vienna');
+  mmkv.set('settings.theme', 'dark');
+
+  const cursor = mmkv.entries({ prefix: 'user.', chunkSize: 1 });
+  const first = cursor.next();
+  expect(first).toHaveLength(1);
+  const second = cursor.next();
+  expect(second).toHaveLength(1);
+  expect(cursor.next()).toBeUndefined();
+  expect([...first!, ...second!].sort(byKey)).toEqual([
+    ['user.city', 'Vienna'],
+    ['user.name', 'Marc'],
+  ]);
+});
+
+test('entries() only returns values of the requested type', () => {
+  mmkv.set('string', 'text');
+  mmkv.set('number', 42);
+  mmkv.set('boolean', true);
+
+  expect(readAll(mmkv.entries())).toEqual([['string', 'text']]);
+  expect(readAll(mmkv.entries({ type: 'number' }))).toEqual([['number', 42]]);
+  expect(readAll(mmkv.entries({ type: 'boolean' }))).toEqual([
+    ['boolean', true],
+  ]);
+});
+
+test('entries() skips keys that are deleted after the cursor was created', () => {
+  mmkv.set('a', '1');
+  mmkv.set('b', '2');
+
+  const cursor = mmkv.entries();
+  mmkv.delete('b');
+  expect(readAll(cursor)).toEqual([['a', '1']]);
+});
+
+test('entries() throws for a chunkSize that is not a positive integer', () => {
+  expect(() => mmkv.entries({ chunkSize: 0 })).toThrow();
+  expect(() => mmkv.entries({ chunkSize: 1.5 })).toThrow();
+  expect(() => mmkv.entries({ chunkSize: NaN })).toThrow();
+  expect(() => mmkv.entries({ chunkSize: Infinity })).toThrow();
+});
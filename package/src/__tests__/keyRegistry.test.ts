@@ -0,0 +1,33 @@
+import { MMKV, defineKeys, type KeyId } from '..';
+
+const mmkv = new MMKV();
+
+beforeEach(() => {
+  mmkv.clearAll();
+});
+
+test('registering a key twice returns the same KeyId', () => {
+  const [theme, locale] = mmkv.registerKeys(['theme', 'locale']);
+  const [themeAgain] = mmkv.registerKeys(['theme']);
+
+  expect(themeAgain).toBe(theme);
+  expect(locale).not.toBe(theme);
+});
+
+test('KeyIds access the same values as their keys', () => {
+  const Keys = defineKeys(mmkv, ['theme', 'count'] as const);
+
+  mmkv.set(Keys.theme, 'dark');
+  expect(mmkv.getString('theme')).toBe('dark');
+
+  mmkv.set('count', 3);
+  expect(mmkv.getNumber(Keys.count)).toBe(3);
+  expect(mmkv.contains(Keys.count)).toBe(true);
+
+  mmkv.delete(Keys.count);
+  expect(mmkv.contains('count')).toBe(false);
+});
+
+test('unregistered KeyIds throw', () => {
+  expect(() => mmkv.getString(123456 as KeyId)).toThrow();
+});
@@ -0,0 +1,70 @@
+import { MMKV } from '..';
+
+const mmkv = new MMKV();
+const compact = new MMKV({ id: 'compact-numbers', compactNumbers: true });
+
+beforeEach(() => {
+  mmkv.clearAll();
+  compact.clearAll();
+});
+
+const numbers = [
+  0,
+  1,
+  2 ** 49 - 1,
+  2 ** 49,
+  2 ** 53,
+  2 ** 56,
+  -1,
+  -(2 ** 49),
+  -(2 ** 56),
+  0.5,
+  -0.5,
+];
+
+const bigints = [
+  0n,
+  2n ** 49n - 1n,
+  2n ** 49n,
+  2n ** 53n + 1n,
+  2n ** 56n - 1n,
+  2n ** 56n,
+  2n ** 63n - 1n,
+  -1n,
+  -(2n ** 49n),
+  -(2n ** 56n),
+  -(2n ** 63n),
+];
+
+test.each(numbers)('numbers round-trip (%p)', (value) => {
+  for (const storage of [mmkv, compact]) {
+    storage.set('number', value);
+    expect(storage.getNumber('number')).toBe(value);
+  }
+});
+
+test.each(bigints)('BigInts round-trip (%p)', (value) => {
+  for (const storage of [mmkv, compact]) {
+    storage.set('bigint', value);
+    expect(storage.getBigInt('bigint')).toBe(value);
+    expect(storage.getNumber('bigint')).toBe(Number(value));
+  }
+});
+
+test('getBigInt reads integral numbers, including negative ones', () => {
+  mmkv.set('number', -42);
+  expect(mmkv.getBigInt('number')).toBe(-42n);
+  mmkv.set('number', 2 ** 49);
+  expect(mmkv.getBigInt('number')).toBe(2n ** 49n);
+});
+
+test('getBigInt does not read fractions or numbers outside of 64 bits', () => {
+  mmkv.set('number', 1.5);
+  expect(mmkv.getBigInt('number')).toBeUndefined();
+  mmkv.set('number', 2 ** 64);
+  expect(mmkv.getBigInt('number')).toBeUndefined();
+});
+
+test('BigInts outside of 64 bits cannot be stored', () => {
+  expect(() => mmkv.set('bigint', 2n ** 64n)).toThrow();
+});
@@ -0,0 +1,43 @@
+import { MMKV } from '..';
+
+const mmkv = new MMKV();
+
+test('items are popped in the order they were pushed', () => {
+  const queue = mmkv.queue('fifo');
+  queue.push(['a', 'b']);
+  queue.push(['c']);
+  expect(queue.size).toBe(3);
+
+  expect(queue.pop(2)).toEqual(['a', 'b']);
+  expect(queue.pop(5)).toEqual(['c']);
+  expect(queue.pop(1)).toEqual([]);
+  expect(queue.size).toBe(0);
+});
+
+test('peek() does not remove items', () => {
+  const queue = mmkv.queue('peek');
+  queue.push(['a', 'b', 'c']);
+
+  expect(queue.peek(2)).toEqual(['a', 'b']);
+  expect(queue.peek(2)).toEqual(['a', 'b']);
+  expect(queue.size).toBe(3);
+});
+
+test('queues are identified by their name', () => {
+  mmkv.queue('uploads').push(['photo']);
+
+  expect(mmkv.queue('uploads').size).toBe(1);
+  expect(mmkv.queue('downloads').size).toBe(0);
+  expect(mmkv.queue('uploads').pop(1)).toEqual(['photo']);
+});
+
+test('peek() and pop() throw for a count that is not a non-negative integer', () => {
+  const queue = mmkv.queue('invalid');
+  queue.push(['a']);
+
+  for (const count of [-1, 0.5, NaN, Infinity]) {
+    expect(() => queue.peek(count)).toThrow();
+    expect(() => queue.pop(count)).toThrow();
+  }
+  expect(queue.size).toBe(1);
+});
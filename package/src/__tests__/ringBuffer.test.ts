@@ -0,0 +1,40 @@
+import { MMKV } from '..';
+
+const mmkv = new MMKV();
+
+test('ring buffers keep only the last `capacity` samples', () => {
+  const ringBuffer = mmkv.ringBuffer('samples', 3);
+  ringBuffer.push(1);
+  ringBuffer.push([2, 3, 4]);
+
+  expect(ringBuffer.capacity).toBe(3);
+  expect(ringBuffer.size).toBe(3);
+  expect(Array.from(ringBuffer.last(10))).toEqual([2, 3, 4]);
+  expect(Array.from(ringBuffer.last(2))).toEqual([3, 4]);
+});
+
+test('ring buffers are identified by their name', () => {
+  mmkv.ringBuffer('fps', 10).push([60, 59]);
+
+  expect(Array.from(mmkv.ringBuffer('fps', 10).last(2))).toEqual([60, 59]);
+  expect(mmkv.ringBuffer('memory', 10).size).toBe(0);
+});
+
+test('opening a ring buffer with a different capacity throws', () => {
+  mmkv.ringBuffer('resized', 4).push([1, 2, 3]);
+
+  expect(() => mmkv.ringBuffer('resized', 2)).toThrow();
+  expect(mmkv.ringBuffer('resized', 4).size).toBe(3);
+});
+
+test('last() throws for a count that is not a non-negative integer', () => {
+  const ringBuffer = mmkv.ringBuffer('invalidCount', 2);
+  for (const count of [-1, 0.5, NaN, Infinity]) {
+    expect(() => ringBuffer.last(count)).toThrow();
+  }
+});
+
+test('ring buffers need a positive integer capacity', () => {
+  expect(() => mmkv.ringBuffer('invalid', 0)).toThrow();
+  expect(() => mmkv.ringBuffer('invalid', 1.5)).toThrow();
+});
@@ -0,0 +1,25 @@
+/**
+ * Throws if `offset` and `length` are not a valid range within a value of `size` bytes,
+ * just like the native `getBufferRange(..)` does.
+ */
+export function checkBufferRange(
+  offset: number,
+  length: number,
+  size: number
+): void {
+  if (
+    !Number.isInteger(offset) ||
+    !Number.isInteger(length) ||
+    offset < 0 ||
+    length < 0
+  ) {
+    throw new Error(
+      "Arguments 'offset' and 'length' have to be non-negative integers!"
+    );
+  }
+  if (offset > size || length > size - offset) {
+    throw new Error(
+      `Arguments 'offset' and 'length' are out of bounds of the value (${size} bytes)!`
+    );
+  }
+}
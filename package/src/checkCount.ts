@@ -0,0 +1,11 @@
+/**
+ * Throws if `count` is not a non-negative integer, just like the native
+ * queues and ring buffers do.
+ */
+export function checkCount(count: number): void {
+  if (!Number.isSafeInteger(count) || count < 0) {
+    throw new Error(
+      "First argument ('count') has to be a non-negative integer!"
+    );
+  }
+}
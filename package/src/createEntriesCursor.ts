@@ -0,0 +1,47 @@
+import type { EntriesCursor, EntriesOptions, NativeMMKV } from './Types';
+
+/**
+ * Creates an {@linkcode EntriesCursor} on top of the regular getters, for platforms
+ * that do not have a native cursor (Web, mocks).
+ */
+export function createEntriesCursor(
+  storage: NativeMMKV,
+  { prefix = '', chunkSize = 100, type = 'string' }: EntriesOptions = {}
+): EntriesCursor {
+  if (!Number.isInteger(chunkSize) || chunkSize < 1 || chunkSize > 2147483647) {
+    throw new Error(
+      "MMKV: 'chunkSize' has to be an integer between 1 and 2147483647!"
+    );
+  }
+  const keys = storage.getAllKeys().filter((key) => key.startsWith(prefix));
+  let position = 0;
+
+  const getValue = (key: string) => {
+    switch (type) {
+      case 'string':
+        return storage.getString(key);
+      case 'number':
+        return storage.getNumber(key);
+      case 'boolean':
+        return storage.getBoolean(key);
+      case 'buffer':
+        return storage.getBuffer(key);
+    }
+  };
+
+  return {
+    next: () => {
+      if (position >= keys.length) return undefined;
+
+      const entries: [string, boolean | string | number | ArrayBuffer][] = [];
+      while (position < keys.length && entries.length < chunkSize) {
+        const key = keys[position++]!;
+        const value = getValue(key);
+        if (value !== undefined) {
+          entries.push([key, value]);
+        }
+      }
+      return entries;
+    },
+  };
+}
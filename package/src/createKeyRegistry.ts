@@ -0,0 +1,31 @@
+import type { KeyId } from './Types';
+
+/**
+ * Creates a registry that maps keys to {@linkcode KeyId}s and back, for platforms
+ * that do not have a native key table (Web, mocks).
+ */
+export function createKeyRegistry() {
+  const keys: string[] = [];
+  const keyIds = new Map<string, KeyId>();
+
+  return {
+    register: (newKeys: string[]): KeyId[] =>
+      newKeys.map((key) => {
+        let keyId = keyIds.get(key);
+        if (keyId == null) {
+          keyId = keys.length as KeyId;
+          keys.push(key);
+          keyIds.set(key, keyId);
+        }
+        return keyId;
+      }),
+    resolve: (key: string | KeyId): string => {
+      if (typeof key === 'string') return key;
+      const name = keys[key];
+      if (name == null) {
+        throw new Error(`MMKV: ${key} is not a registered KeyId!`);
+      }
+      return name;
+    },
+  };
+}
@@ -1,38 +1,216 @@
-import type { NativeMMKV } from './Types';
+import type { MMKVQueue, NativeMMKV } from './Types';
+import { checkBufferRange } from './checkBufferRange';
+import { checkCount } from './checkCount';
+import { createEntriesCursor } from './createEntriesCursor';
+import { createKeyRegistry } from './createKeyRegistry';
+import { createRingBuffer } from './createRingBuffer';
+import { createTextEncoder } from './createTextEncoder';
 
 /* Mock MMKV instance for use in tests */
 export const createMockMMKV = (): NativeMMKV => {
-  const storage = new Map<string, string | boolean | number | ArrayBuffer>();
+  const storage = new Map<
+    string,
+    string | boolean | number | bigint | ArrayBuffer
+  >();
+  const queues = new Map<string, MMKVQueue>();
+  const keyRegistry = createKeyRegistry();
+  const ringBuffers = new Map<
+    string,
+    { capacity: number; samples: number[] }
+  >();
 
-  return {
-    clearAll: () => storage.clear(),
-    delete: (key) => storage.delete(key),
-    set: (key, value) => storage.set(key, value),
+  // The latest sequence number of every changed key, negated for deletes
+  const changeLog = new Map<string, number>();
+  let sequence = 0;
+  const recordChange = (key: string, isDeleted: boolean) => {
+    sequence++;
+    changeLog.set(key, isDeleted ? -sequence : sequence);
+  };
+
+  const mmkv: NativeMMKV = {
+    clearAll: () => {
+      storage.forEach((_, key) => recordChange(key, true));
+      storage.clear();
+    },
+    delete: (keyOrId) => {
+      const key = keyRegistry.resolve(keyOrId);
+      storage.delete(key);
+      recordChange(key, true);
+    },
+    set: (keyOrId, value) => {
+      const key = keyRegistry.resolve(keyOrId);
+      if (typeof value === 'bigint' && BigInt.asIntN(64, value) !== value) {
+        throw new Error("MMKV::set: 'value' BigInt does not fit into 64 bits!");
+      }
+      storage.set(key, value);
+      recordChange(key, false);
+      return true;
+    },
+    concatBuffer: (keyOrId, data) => {
+      const key = keyRegistry.resolve(keyOrId);
+      const existing = storage.get(key);
+      const previous = existing instanceof ArrayBuffer ? existing : undefined;
+      const combined = new Uint8Array((previous?.byteLength ?? 0) + data.byteLength);
+      if (previous != null) combined.set(new Uint8Array(previous), 0);
+      combined.set(new Uint8Array(data), previous?.byteLength ?? 0);
+      storage.set(key, combined.buffer);
+      recordChange(key, false);
+    },
+    concatString: (keyOrId, text) => {
+      const key = keyRegistry.resolve(keyOrId);
+      const existing = storage.get(key);
+      storage.set(key, (typeof existing === 'string' ? existing : '') + text);
+      recordChange(key, false);
+    },
     getString: (key) => {
-      const result = storage.get(key);
+      const result = storage.get(keyRegistry.resolve(key));
       return typeof result === 'string' ? result : undefined;
     },
     getNumber: (key) => {
-      const result = storage.get(key);
+      const result = storage.get(keyRegistry.resolve(key));
+      if (typeof result === 'bigint') return Number(result);
       return typeof result === 'number' ? result : undefined;
     },
+    getBigInt: (key) => {
+      const result = storage.get(keyRegistry.resolve(key));
+      if (typeof result === 'bigint') return result;
+      if (!Number.isInteger(result)) return undefined;
+      const value = BigInt(result as number);
+      return BigInt.asIntN(64, value) === value ? value : undefined;
+    },
     getBoolean: (key) => {
-      const result = storage.get(key);
+      const result = storage.get(keyRegistry.resolve(key));
       return typeof result === 'boolean' ? result : undefined;
     },
     getBuffer: (key) => {
-      const result = storage.get(key);
+      const result = storage.get(keyRegistry.resolve(key));
       return result instanceof ArrayBuffer ? result : undefined;
     },
+    getBufferRange: (key, offset, length) => {
+      const result = storage.get(keyRegistry.resolve(key));
+      if (!(result instanceof ArrayBuffer)) return undefined;
+      checkBufferRange(offset, length, result.byteLength);
+      return result.slice(offset, offset + length);
+    },
+    getValueSize: (key) => {
+      const result = storage.get(keyRegistry.resolve(key));
+      if (result == null) return undefined;
+      if (result instanceof ArrayBuffer) return result.byteLength;
+      if (typeof result === 'string') {
+        return createTextEncoder().encode(result).byteLength;
+      }
+      return typeof result === 'boolean' ? 1 : 8;
+    },
     getAllKeys: () => Array.from(storage.keys()),
-    contains: (key) => storage.has(key),
+    diff: (other) => {
+      if (!('getAllKeys' in other)) {
+        throw new Error('Diffing files is not supported in mocked MMKV instances!');
+      }
+      const otherKeys = new Set(other.getAllKeys());
+      // Reads the other value with the getter for this value's type.
+      const isEqual = (key: string) => {
+        const value = storage.get(key);
+        switch (typeof value) {
+          case 'string':
+            return other.getString(key) === value;
+          case 'number':
+            return other.getNumber(key) === value;
+          case 'bigint':
+            return other.getBigInt(key) === value;
+          case 'boolean':
+            return other.getBoolean(key) === value;
+        }
+        const otherValue = other.getBuffer(key);
+        if (value == null || otherValue == null) return false;
+        const bytes = new Uint8Array(value);
+        const otherBytes = new Uint8Array(otherValue);
+        return (
+          bytes.length === otherBytes.length &&
+          bytes.every((byte, index) => byte === otherBytes[index])
+        );
+      };
+      const keys = Array.from(storage.keys());
+      return {
+        added: [...otherKeys].filter((key) => !storage.has(key)).sort(),
+        removed: keys.filter((key) => !otherKeys.has(key)).sort(),
+        changed: keys
+          .filter((key) => otherKeys.has(key) && !isEqual(key))
+          .sort(),
+      };
+    },
+    entries: (options) => createEntriesCursor(mmkv, options),
+    queue: (name) => {
+      let queue = queues.get(name);
+      if (queue == null) {
+        const items: string[] = [];
+        queue = {
+          push: (newItems) => items.push(...newItems),
+          peek: (count) => {
+            checkCount(count);
+            return items.slice(0, count);
+          },
+          pop: (count) => {
+            checkCount(count);
+            return items.splice(0, count);
+          },
+          get size() {
+            return items.length;
+          },
+        };
+        queues.set(name, queue);
+      }
+      return queue;
+    },
+    ringBuffer: (name, capacity) =>
+      createRingBuffer(
+        capacity,
+        () => ringBuffers.get(name),
+        (state) => ringBuffers.set(name, state)
+      ),
+    contains: (key) => storage.has(keyRegistry.resolve(key)),
+    registerKeys: (keys) => keyRegistry.register(keys),
     recrypt: () => {
       console.warn('Encryption is not supported in mocked MMKV instances!');
     },
+    changesSince: (since, limit = 1000) => {
+      const changes = [...changeLog.entries()]
+        .filter(([, change]) => Math.abs(change) > since)
+        .sort(([, a], [, b]) => Math.abs(a) - Math.abs(b));
+      const page = changes.slice(0, limit);
+      const hasMore = changes.length > limit;
+      return {
+        changed: page.filter(([, change]) => change > 0).map(([key]) => key),
+        deleted: page.filter(([, change]) => change < 0).map(([key]) => key),
+        sequence: hasMore
+          ? Math.abs(page[page.length - 1]![1])
+          : Math.max(since, sequence),
+        hasMore,
+      };
+    },
+    truncateChangesBefore: (before) => {
+      let removed = 0;
+      changeLog.forEach((change, key) => {
+        // Like the native log, the latest change is always kept
+        if (Math.abs(change) <= before && Math.abs(change) !== sequence) {
+          changeLog.delete(key);
+          removed++;
+        }
+      });
+      return removed;
+    },
     size: 0,
+    mirrorMetrics: undefined,
     isReadOnly: false,
     trim: () => {
       // no-op
     },
+    flush: () => Promise.resolve(),
+    handleMemoryPressure: () => {
+      // no-op
+    },
+    prefetch: () => {
+      // no-op
+    },
   };
+  return mmkv;
 };
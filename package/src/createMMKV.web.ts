@@ -1,6 +1,11 @@
 /* global localStorage */
-import type { Configuration, NativeMMKV } from './Types';
+import type { Configuration, KeyId, NativeMMKV } from './Types';
+import { checkBufferRange } from './checkBufferRange';
+import { checkCount } from './checkCount';
 import { createTextEncoder } from './createTextEncoder';
+import { createEntriesCursor } from './createEntriesCursor';
+import { createKeyRegistry } from './createKeyRegistry';
+import { createRingBuffer } from './createRingBuffer';
 
 const canUseDOM =
   typeof window !== 'undefined' && window.document?.createElement != null;
@@ -26,6 +31,12 @@ export const createMMKV = (config: Configuration): NativeMMKV => {
   if (config.path != null) {
     throw new Error("MMKV: 'path' is not supported on Web!");
   }
+  if (config.overlayBasePath != null) {
+    throw new Error("MMKV: 'overlayBasePath' is not supported on Web!");
+  }
+  if (config.mirrorPath != null) {
+    throw new Error("MMKV: 'mirrorPath' is not supported on Web!");
+  }
 
   // canUseDOM check prevents spam in Node server environments, such as Next.js server side props.
   if (!hasAccessToLocalStorage() && canUseDOM) {
@@ -70,7 +81,9 @@ export const createMMKV = (config: Configuration): NativeMMKV => {
   }
 
   const keyPrefix = `${config.id}${KEY_WILDCARD}`; // mmkv.default\\
-  const prefixedKey = (key: string) => {
+  const keyRegistry = createKeyRegistry();
+  const prefixedKey = (keyOrId: string | KeyId) => {
+    const key = keyRegistry.resolve(keyOrId);
     if (key.includes('\\')) {
       throw new Error(
         'MMKV: `key` cannot contain the backslash character (`\\`)!'
@@ -79,7 +92,7 @@ export const createMMKV = (config: Configuration): NativeMMKV => {
     return `${keyPrefix}${key}`;
   };
 
-  return {
+  const mmkv: NativeMMKV = {
     clearAll: () => {
       const keys = Object.keys(storage());
       for (const key of keys) {
@@ -90,7 +103,22 @@ export const createMMKV = (config: Configuration): NativeMMKV => {
     },
     delete: (key) => storage().removeItem(prefixedKey(key)),
     set: (key, value) => {
-      storage().setItem(prefixedKey(key), value.toString());
+      const serialized = value.toString();
+      if (
+        config.compareBeforeSet === true &&
+        storage().getItem(prefixedKey(key)) === serialized
+      ) {
+        return false;
+      }
+      storage().setItem(prefixedKey(key), serialized);
+      return true;
+    },
+    concatBuffer: () => {
+      throw new Error('`concatBuffer(..)` is not supported on Web!');
+    },
+    concatString: (key, text) => {
+      const existing = storage().getItem(prefixedKey(key)) ?? '';
+      storage().setItem(prefixedKey(key), existing + text);
     },
     getString: (key) => storage().getItem(prefixedKey(key)) ?? undefined,
     getNumber: (key) => {
@@ -98,6 +126,11 @@ export const createMMKV = (config: Configuration): NativeMMKV => {
       if (value == null) return undefined;
       return Number(value);
     },
+    getBigInt: (key) => {
+      const value = storage().getItem(prefixedKey(key));
+      if (value == null || !/^-?\d+$/.test(value)) return undefined;
+      return BigInt(value);
+    },
     getBoolean: (key) => {
       const value = storage().getItem(prefixedKey(key));
       if (value == null) return undefined;
@@ -108,20 +141,88 @@ export const createMMKV = (config: Configuration): NativeMMKV => {
       if (value == null) return undefined;
       return textEncoder.encode(value);
     },
+    getBufferRange: (key, offset, length) => {
+      const value = storage().getItem(prefixedKey(key));
+      if (value == null) return undefined;
+      const buffer = textEncoder.encode(value).buffer;
+      checkBufferRange(offset, length, buffer.byteLength);
+      return buffer.slice(offset, offset + length);
+    },
+    getValueSize: (key) => {
+      const value = storage().getItem(prefixedKey(key));
+      if (value == null) return undefined;
+      return textEncoder.encode(value).byteLength;
+    },
     getAllKeys: () => {
       const keys = Object.keys(storage());
       return keys
         .filter((key) => key.startsWith(keyPrefix))
         .map((key) => key.slice(keyPrefix.length));
     },
+    entries: (options) => createEntriesCursor(mmkv, options),
+    queue: (name) => {
+      // Starts with the wildcard, so it never collides with (or shows up in) instance keys.
+      const queueKey = `${KEY_WILDCARD}queue${KEY_WILDCARD}${config.id}${KEY_WILDCARD}${name}`;
+      const read = (): string[] =>
+        JSON.parse(storage().getItem(queueKey) ?? '[]');
+      const write = (items: string[]) =>
+        storage().setItem(queueKey, JSON.stringify(items));
+      return {
+        push: (items) => write([...read(), ...items]),
+        peek: (count) => {
+          checkCount(count);
+          return read().slice(0, count);
+        },
+        pop: (count) => {
+          checkCount(count);
+          const items = read();
+          const popped = items.splice(0, count);
+          write(items);
+          return popped;
+        },
+        get size() {
+          return read().length;
+        },
+      };
+    },
+    ringBuffer: (name, capacity) => {
+      const ringBufferKey = `${KEY_WILDCARD}ringBuffer${KEY_WILDCARD}${config.id}${KEY_WILDCARD}${name}`;
+      return createRingBuffer(
+        capacity,
+        () => {
+          const value = storage().getItem(ringBufferKey);
+          return value == null ? undefined : JSON.parse(value);
+        },
+        (state) => storage().setItem(ringBufferKey, JSON.stringify(state))
+      );
+    },
     contains: (key) => storage().getItem(prefixedKey(key)) != null,
+    registerKeys: (keys) => keyRegistry.register(keys),
     recrypt: () => {
       throw new Error('`recrypt(..)` is not supported on Web!');
     },
+    diff: () => {
+      throw new Error('`diff(..)` is not supported on Web!');
+    },
+    changesSince: () => {
+      throw new Error('`changesSince(..)` is not supported on Web!');
+    },
+    truncateChangesBefore: () => {
+      throw new Error('`truncateChangesBefore(..)` is not supported on Web!');
+    },
     size: 0,
+    mirrorMetrics: undefined,
     isReadOnly: false,
     trim: () => {
       // no-op
     },
+    flush: () => Promise.resolve(),
+    handleMemoryPressure: () => {
+      // no-op
+    },
+    prefetch: () => {
+      // no-op
+    },
   };
+  return mmkv;
 };
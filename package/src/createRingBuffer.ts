@@ -0,0 +1,46 @@
+import { checkCount } from './checkCount';
+import type { MMKVRingBuffer } from './Types';
+
+interface RingBufferState {
+  capacity: number;
+  // oldest sample first
+  samples: number[];
+}
+
+/**
+ * Creates an {@linkcode MMKVRingBuffer} on top of a plain array, for platforms
+ * that do not have a native ring buffer (Web, mocks).
+ */
+export function createRingBuffer(
+  capacity: number,
+  load: () => RingBufferState | undefined,
+  save: (state: RingBufferState) => void
+): MMKVRingBuffer {
+  if (!Number.isInteger(capacity) || capacity < 1) {
+    throw new Error("MMKV: 'capacity' has to be a positive integer!");
+  }
+  const existing = load();
+  if (existing != null && existing.capacity !== capacity) {
+    throw new Error(
+      `MMKV: The ring buffer already exists with a capacity of ${existing.capacity}!`
+    );
+  }
+  const read = (): number[] => load()?.samples ?? [];
+
+  return {
+    push: (values) => {
+      const samples = read().concat(values);
+      save({ capacity, samples: samples.slice(-capacity) });
+    },
+    last: (count) => {
+      checkCount(count);
+      const samples = read();
+      const start = samples.length - Math.min(count, samples.length);
+      return Float64Array.from(samples.slice(start));
+    },
+    get size() {
+      return read().length;
+    },
+    capacity,
+  };
+}
@@ -0,0 +1,24 @@
+import type { KeyId, NativeMMKV } from './Types';
+
+/**
+ * Registers the given keys on the given instance, and returns an object that maps
+ * each key to its {@linkcode KeyId}.
+ *
+ * @example
+ * ```ts
+ * const Keys = defineKeys(storage, ['theme', 'locale'] as const)
+ * storage.set(Keys.theme, 'dark')
+ * const theme = storage.getString(Keys.theme)
+ * ```
+ */
+export function defineKeys<K extends string>(
+  storage: Pick<NativeMMKV, 'registerKeys'>,
+  keys: readonly K[]
+): Record<K, KeyId> {
+  const keyIds = storage.registerKeys([...keys]);
+  const result = {} as Record<K, KeyId>;
+  keys.forEach((key, index) => {
+    result[key] = keyIds[index]!;
+  });
+  return result;
+}
@@ -1,4 +1,19 @@
 export * from './MMKV';
 export * from './hooks';
+export { defineKeys } from './defineKeys';
 
-export { Mode, type Configuration } from './Types';
+export {
+  Mode,
+  type ChangeSet,
+  type Configuration,
+  type EntriesCursor,
+  type EntriesOptions,
+  type KeyId,
+  type MemoryPressureLevel,
+  type MirrorMetrics,
+  type MMKVDiff,
+  type MMKVFileReference,
+  type MMKVQueue,
+  type MMKVRingBuffer,
+  type ValueType,
+} from './Types';
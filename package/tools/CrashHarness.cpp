@@ -0,0 +1,403 @@
+//
+//  CrashHarness.cpp
+//  react-native-mmkv
+//
+//  Repeatedly SIGKILLs a process that writes to an MMKV instance at a random point (while it is
+//  appending, compacting or recrypting), then re-opens the instance in a fresh process and verifies
+//  it. Reports the time it took to open (and recover) the instance, acknowledged writes that got
+//  lost, and values that came back corrupted.
+//
+//  Usage: mmkv-crash-harness [--dir <path>] [--iterations <n>] [--seed <n>]
+//
+
+#include "MMKV.h"
+#include "MmkvRecovery.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <poll.h>
+#include <random>
+#include <signal.h>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+using namespace mmkv;
+
+static const std::string kInstanceId = "crash-harness";
+static const std::vector<std::string> kCryptKeys = {"", "harness-key-1", "harness-key-2"};
+static constexpr uint32_t kKeySpace = 4096;
+static constexpr int64_t kDeleted = -1;
+
+enum class Phase { Append, Compact, Recrypt };
+
+static const char* getPhaseName(Phase phase) {
+  switch (phase) {
+    case Phase::Append:
+      return "append";
+    case Phase::Compact:
+      return "compact";
+    case Phase::Recrypt:
+      return "recrypt";
+  }
+  return "unknown";
+}
+
+// Values carry their own key, sequence number and checksum, so the verifier can tell a valid value
+// from garbage.
+static uint64_t checksum(const std::string& key, uint64_t seq) {
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : key + "#" + std::to_string(seq)) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+  }
+  return hash;
+}
+
+static std::string makeValue(const std::string& key, uint64_t seq, size_t padding) {
+  return key + "|" + std::to_string(seq) + "|" + std::to_string(checksum(key, seq)) + "|" +
+         std::string(padding, 'x');
+}
+
+// Returns the sequence number of the value, or -1 if it is not a valid value for the key.
+static int64_t parseValue(const std::string& key, const std::string& value) {
+  size_t first = value.find('|');
+  size_t second = value.find('|', first + 1);
+  size_t third = value.find('|', second + 1);
+  if (first == std::string::npos || second == std::string::npos || third == std::string::npos) {
+    return -1;
+  }
+  if (value.compare(0, first, key) != 0) {
+    return -1;
+  }
+  try {
+    uint64_t seq = std::stoull(value.substr(first + 1, second - first - 1));
+    uint64_t sum = std::stoull(value.substr(second + 1, third - second - 1));
+    return sum == checksum(key, seq) ? static_cast<int64_t>(seq) : -1;
+  } catch (const std::exception&) {
+    return -1;
+  }
+}
+
+static MMKV* openInstance(size_t cryptIndex) {
+  std::string cryptKey = kCryptKeys[cryptIndex];
+  return MMKV::mmkvWithID(kInstanceId, DEFAULT_MMAP_SIZE, MMKV_SINGLE_PROCESS,
+                          cryptKey.empty() ? nullptr : &cryptKey);
+}
+
+static void writeLine(int fd, const std::string& line) {
+  std::string data = line + "\n";
+  const char* ptr = data.data();
+  size_t remaining = data.size();
+  while (remaining > 0) {
+    ssize_t written = write(fd, ptr, remaining);
+    if (written <= 0) {
+      _exit(2);
+    }
+    ptr += written;
+    remaining -= static_cast<size_t>(written);
+  }
+}
+
+// Writes forever (until it gets killed), reporting every acknowledged mutation to `reportFd`.
+[[noreturn]] static void runWriter(const std::string& dir, size_t cryptIndex, Phase phase,
+                                   uint64_t firstSeq, uint32_t seed, int reportFd) {
+  MMKV::initializeMMKV(dir, MMKVLogNone);
+  MmkvRecovery::install();
+  MMKV* mmkv;
+  {
+    MmkvRecovery::OpeningScope recoveryScope(true);
+    mmkv = openInstance(cryptIndex);
+  }
+  if (mmkv == nullptr) {
+    _exit(3);
+  }
+  MmkvRecovery::setRecoverOnCorruption(mmkv->mmapID(), true);
+
+  std::mt19937 random(seed);
+  uint64_t seq = firstSeq;
+  auto append = [&](size_t padding) {
+    std::string key = "key-" + std::to_string(random() % kKeySpace);
+    mmkv->set(makeValue(key, seq, padding), key);
+    writeLine(reportFd, "S " + key + " " + std::to_string(seq));
+    seq++;
+  };
+
+  while (true) {
+    switch (phase) {
+      case Phase::Append:
+        append(random() % 256);
+        break;
+      case Phase::Compact:
+        // Deleting a bunch of keys and trimming makes MMKV rewrite the whole file, and large values
+        // make it run out of space and do a full write-back again.
+        for (int i = 0; i < 64; i++) {
+          std::string key = "key-" + std::to_string(random() % kKeySpace);
+          mmkv->removeValueForKey(key);
+          writeLine(reportFd, "D " + key);
+        }
+        mmkv->trim();
+        for (int i = 0; i < 16; i++) {
+          append(4096 + random() % 4096);
+        }
+        break;
+      case Phase::Recrypt:
+        cryptIndex = (cryptIndex + 1) % kCryptKeys.size();
+        writeLine(reportFd, "R " + std::to_string(cryptIndex));
+        mmkv->reKey(kCryptKeys[cryptIndex]);
+        writeLine(reportFd, "K " + std::to_string(cryptIndex));
+        for (int i = 0; i < 32; i++) {
+          append(random() % 256);
+        }
+        break;
+    }
+  }
+}
+
+static size_t countValidValues(MMKV* mmkv) {
+  size_t valid = 0;
+  for (const std::string& key : mmkv->allKeys()) {
+    std::string value;
+    if (mmkv->getString(key, value) && parseValue(key, value) >= 0) {
+      valid++;
+    }
+  }
+  return valid;
+}
+
+// Opens the instance in a fresh process and reports its contents to `reportFd`.
+[[noreturn]] static void runVerifier(const std::string& dir, std::vector<size_t> cryptCandidates,
+                                     int reportFd) {
+  MMKV::initializeMMKV(dir, MMKVLogNone);
+  MmkvRecovery::install();
+
+  auto start = std::chrono::steady_clock::now();
+  MMKV* mmkv;
+  size_t recoveries;
+  {
+    MmkvRecovery::OpeningScope recoveryScope(true);
+    mmkv = openInstance(cryptCandidates.front());
+    recoveries = recoveryScope.getRecoveryCount();
+  }
+  auto openDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  if (mmkv == nullptr) {
+    _exit(3);
+  }
+  MmkvRecovery::setRecoverOnCorruption(mmkv->mmapID(), true);
+
+  // If we got killed in the middle of a recrypt, we don't know which key the file uses now.
+  size_t cryptIndex = cryptCandidates.front();
+  if (cryptCandidates.size() > 1) {
+    size_t bestValid = countValidValues(mmkv);
+    for (size_t i = 1; i < cryptCandidates.size(); i++) {
+      std::string cryptKey = kCryptKeys[cryptCandidates[i]];
+      mmkv->checkReSetCryptKey(cryptKey.empty() ? nullptr : &cryptKey);
+      size_t valid = countValidValues(mmkv);
+      if (valid > bestValid) {
+        bestValid = valid;
+        cryptIndex = cryptCandidates[i];
+      }
+    }
+    std::string cryptKey = kCryptKeys[cryptIndex];
+    mmkv->checkReSetCryptKey(cryptKey.empty() ? nullptr : &cryptKey);
+  }
+
+  writeLine(reportFd, "O " + std::to_string(openDuration.count()) + " " +
+                          std::to_string(recoveries) + " " + std::to_string(cryptIndex));
+  for (const std::string& key : mmkv->allKeys()) {
+    std::string value;
+    int64_t seq = mmkv->getString(key, value) ? parseValue(key, value) : -1;
+    writeLine(reportFd, seq >= 0 ? "V " + key + " " + std::to_string(seq) : "C " + key);
+  }
+  _exit(0);
+}
+
+// Reads lines from `fd` until EOF, or until `deadline` has passed.
+static void readLines(int fd, std::string& buffer, std::chrono::steady_clock::time_point deadline) {
+  char chunk[16 * 1024];
+  while (true) {
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now());
+    if (remaining.count() <= 0) {
+      return;
+    }
+    struct pollfd pollFd = {fd, POLLIN, 0};
+    int timeout = static_cast<int>(std::min<int64_t>(remaining.count(), INT32_MAX));
+    if (poll(&pollFd, 1, timeout) <= 0) {
+      continue;
+    }
+    ssize_t bytesRead = read(fd, chunk, sizeof(chunk));
+    if (bytesRead <= 0) {
+      return;
+    }
+    buffer.append(chunk, static_cast<size_t>(bytesRead));
+  }
+}
+
+template <typename Func> static pid_t spawn(int& readFd, Func&& body) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    std::perror("pipe");
+    std::exit(1);
+  }
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    body(fds[1]);
+    _exit(0);
+  }
+  close(fds[1]);
+  readFd = fds[0];
+  return pid;
+}
+
+struct Stats {
+  size_t iterations = 0;
+  size_t recoveries = 0;
+  size_t lostWrites = 0;
+  size_t resurrectedDeletes = 0;
+  size_t corruptValues = 0;
+  int64_t totalOpenMicros = 0;
+  int64_t maxOpenMicros = 0;
+};
+
+int main(int argc, char** argv) {
+  std::string dir = "/tmp/mmkv-crash-harness";
+  size_t iterations = 100;
+  uint32_t seed = static_cast<uint32_t>(std::random_device()());
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (std::strcmp(argv[i], "--dir") == 0) {
+      dir = argv[i + 1];
+    } else if (std::strcmp(argv[i], "--iterations") == 0) {
+      iterations = std::stoul(argv[i + 1]);
+    } else if (std::strcmp(argv[i], "--seed") == 0) {
+      seed = static_cast<uint32_t>(std::stoul(argv[i + 1]));
+    } else {
+      std::fprintf(stderr, "Usage: %s [--dir <path>] [--iterations <n>] [--seed <n>]\n", argv[0]);
+      return 1;
+    }
+  }
+  mkdir(dir.c_str(), 0755);
+  std::printf("Running %zu iterations in %s (seed: %u)\n", iterations, dir.c_str(), seed);
+
+  std::mt19937 random(seed);
+  // key -> last acknowledged sequence number (or kDeleted)
+  std::unordered_map<std::string, int64_t> expected;
+  size_t cryptIndex = 0;
+  uint64_t nextSeq = 1;
+  Stats stats;
+
+  for (size_t iteration = 0; iteration < iterations; iteration++) {
+    Phase phase = static_cast<Phase>(random() % 3);
+    uint32_t writerSeed = static_cast<uint32_t>(random());
+    auto killAfter = std::chrono::microseconds(1000 + random() % 50000);
+
+    // 1. Write until we get killed at a random point
+    int writerFd;
+    pid_t writer = spawn(writerFd, [&](int fd) {
+      runWriter(dir, cryptIndex, phase, nextSeq, writerSeed, fd);
+    });
+    std::string output;
+    readLines(writerFd, output, std::chrono::steady_clock::now() + killAfter);
+    kill(writer, SIGKILL);
+    waitpid(writer, nullptr, 0);
+    readLines(writerFd, output, std::chrono::steady_clock::now() + std::chrono::seconds(1));
+    close(writerFd);
+
+    std::vector<size_t> cryptCandidates = {cryptIndex};
+    std::istringstream lines(output);
+    std::string line;
+    while (std::getline(lines, line)) {
+      std::istringstream fields(line);
+      std::string type, key;
+      fields >> type;
+      if (type == "S") {
+        int64_t seq;
+        fields >> key >> seq;
+        expected[key] = seq;
+        nextSeq = std::max(nextSeq, static_cast<uint64_t>(seq) + 1);
+      } else if (type == "D") {
+        fields >> key;
+        expected[key] = kDeleted;
+      } else if (type == "R") {
+        size_t next;
+        fields >> next;
+        cryptCandidates = {next, cryptIndex};
+      } else if (type == "K") {
+        fields >> cryptIndex;
+        cryptCandidates = {cryptIndex};
+      }
+    }
+
+    // 2. Re-open it in a fresh process and compare against what was acknowledged
+    int verifierFd;
+    pid_t verifier =
+        spawn(verifierFd, [&](int fd) { runVerifier(dir, cryptCandidates, fd); });
+    output.clear();
+    readLines(verifierFd, output, std::chrono::steady_clock::now() + std::chrono::minutes(1));
+    close(verifierFd);
+    int status = 0;
+    waitpid(verifier, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      std::printf("#%zu (%s): verifier failed to open the instance!\n", iteration,
+                  getPhaseName(phase));
+      return 1;
+    }
+
+    std::unordered_map<std::string, int64_t> found;
+    int64_t openMicros = 0;
+    size_t recoveries = 0, corrupt = 0;
+    lines = std::istringstream(output);
+    while (std::getline(lines, line)) {
+      std::istringstream fields(line);
+      std::string type, key;
+      fields >> type;
+      if (type == "O") {
+        fields >> openMicros >> recoveries >> cryptIndex;
+      } else if (type == "V") {
+        int64_t seq;
+        fields >> key >> seq;
+        found[key] = seq;
+      } else if (type == "C") {
+        corrupt++;
+      }
+    }
+
+    size_t lost = 0, resurrected = 0;
+    for (const auto& [key, seq] : expected) {
+      auto actual = found.find(key);
+      if (seq == kDeleted) {
+        resurrected += actual != found.end() ? 1 : 0;
+      } else if (actual == found.end() || actual->second < seq) {
+        lost++;
+      }
+    }
+    // Continue from what actually survived
+    expected = found;
+
+    stats.iterations++;
+    stats.recoveries += recoveries;
+    stats.lostWrites += lost;
+    stats.resurrectedDeletes += resurrected;
+    stats.corruptValues += corrupt;
+    stats.totalOpenMicros += openMicros;
+    stats.maxOpenMicros = std::max(stats.maxOpenMicros, openMicros);
+    std::printf("#%zu (%s): %zu keys, open %.2f ms%s, %zu lost, %zu resurrected, %zu corrupt\n",
+                iteration, getPhaseName(phase), found.size(), openMicros / 1000.0,
+                recoveries > 0 ? " (recovered)" : "", lost, resurrected, corrupt);
+  }
+
+  std::printf("\n%zu iterations, %zu recoveries\n", stats.iterations, stats.recoveries);
+  std::printf("Open time: %.2f ms average, %.2f ms max\n",
+              stats.totalOpenMicros / 1000.0 / std::max<size_t>(stats.iterations, 1),
+              stats.maxOpenMicros / 1000.0);
+  std::printf("Lost writes: %zu, resurrected deletes: %zu, corrupt values: %zu\n",
+              stats.lostWrites, stats.resurrectedDeletes, stats.corruptValues);
+  return stats.lostWrites == 0 && stats.corruptValues == 0 ? 0 : 1;
+}
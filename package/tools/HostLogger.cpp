@@ -0,0 +1,11 @@
+//
+//  HostLogger.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvLogger.h"
+#include <cstdio>
+
+void MmkvLogger::log(const std::string& tag, const std::string& message) {
+  std::fprintf(stderr, "[%s]: %s\n", tag.c_str(), message.c_str());
+}
@@ -0,0 +1,428 @@
+//
+//  Inspect.cpp
+//  react-native-mmkv
+//
+//  Opens MMKV instance files (e.g. pulled from a test device) on a workstation, to diagnose them:
+//  print stats and fragmentation, dump or grep entries, verify CRCs, compact or recrypt the file
+//  offline, and benchmark lookups.
+//
+//  Usage: mmkv-inspect <command> --dir <path> --id <id> [--key <encryptionKey>] [options]
+//
+
+#include "Json.h"
+#include "MMKV.h"
+#include "MmkvKeyCodec.h"
+#include "MmkvNumbers.h"
+#include "MmkvRecovery.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace mmkv;
+
+enum class ValueType { Auto, String, Number, Boolean, Buffer };
+
+struct Options {
+  std::string command;
+  std::string dir;
+  std::string id;
+  std::string encryptionKey;
+  std::string newEncryptionKey;
+  bool hasNewEncryptionKey = false;
+  std::string pattern;
+  ValueType type = ValueType::Auto;
+  size_t iterations = 100000;
+  std::vector<std::string> keyPrefixes;
+};
+
+static void printUsage(const char* program) {
+  std::fprintf(stderr,
+               "Usage: %s <command> --dir <path> --id <id> [--key <encryptionKey>] [options]\n\n"
+               "Commands:\n"
+               "  stats                      Print sizes, key count and fragmentation\n"
+               "  dump [--type <type>]       Print all entries as NDJSON\n"
+               "  grep <regex> [--type <t>]  Print entries whose key or string value matches\n"
+               "  verify                     Check the CRC and that every value is readable\n"
+               "  compact                    Rewrite the file without overwritten records\n"
+               "  recrypt --new-key <key>    Re-encrypt the file (an empty key decrypts it)\n"
+               "  bench [--iterations <n>]   Measure open time and lookup latency\n\n"
+               "MMKV does not store value types, so dump and grep guess them unless --type is\n"
+               "one of string, number, boolean or buffer. Pass the instance's `keyPrefixes` (in\n"
+               "order) as --key-prefix to print front-coded keys decoded.\n",
+               program);
+}
+
+static bool isValidUtf8(const std::string& text) {
+  size_t i = 0;
+  while (i < text.size()) {
+    unsigned char c = static_cast<unsigned char>(text[i]);
+    size_t length = c < 0x80            ? 1
+                    : (c >> 5) == 0x06 ? 2
+                    : (c >> 4) == 0x0E ? 3
+                    : (c >> 3) == 0x1E ? 4
+                                       : 0;
+    if (length == 0 || i + length > text.size()) {
+      return false;
+    }
+    for (size_t j = 1; j < length; j++) {
+      if ((static_cast<unsigned char>(text[i + j]) & 0xC0) != 0x80) {
+        return false;
+      }
+    }
+    i += length;
+  }
+  return true;
+}
+
+static bool isLengthDelimited(MMKV* mmkv, const std::string& key) {
+  // For strings and buffers the payload is smaller than the raw value (it has a length prefix).
+  return mmkv->getValueSize(key, true) != mmkv->getValueSize(key, false);
+}
+
+// Returns the value as JSON. Buffers (and strings that are not valid UTF-8) become
+// {"$base64": "..."}.
+static std::string readValueAsJson(MMKV* mmkv, const std::string& key, ValueType type) {
+  if (type == ValueType::Auto) {
+    if (isLengthDelimited(mmkv, key)) {
+      type = ValueType::String;
+    } else {
+      // Numbers are stored as 8-byte doubles, or as varint integers.
+      type = ValueType::Number;
+    }
+  }
+
+  JsonValue value;
+  switch (type) {
+    case ValueType::Number: {
+      bool hasValue;
+      value.number = MmkvNumbers::get(mmkv, key, &hasValue);
+      value.type = hasValue ? JsonValue::Type::Number : JsonValue::Type::Null;
+      return toJson(value);
+    }
+    case ValueType::Boolean:
+      value.type = JsonValue::Type::Boolean;
+      value.boolean = mmkv->getBool(key);
+      return toJson(value);
+    case ValueType::String:
+    case ValueType::Buffer:
+    case ValueType::Auto: {
+      MMBuffer buffer;
+      mmkv->getBytes(key, buffer);
+      std::string text(static_cast<const char*>(buffer.getPtr()), buffer.length());
+      if (type == ValueType::String && isValidUtf8(text)) {
+        return quoteJson(text);
+      }
+      return "{\"$base64\":" +
+             quoteJson(toBase64(static_cast<const uint8_t*>(buffer.getPtr()), buffer.length())) +
+             "}";
+    }
+  }
+  return "null";
+}
+
+static void printEntry(const std::string& key, const std::string& valueJson) {
+  std::printf("{%s:%s}\n", quoteJson(key).c_str(), valueJson.c_str());
+}
+
+// Opens the instance, and recovers it instead of discarding it if it is corrupted - a file that is
+// being inspected must never be discarded. `recoveries` is set to how often it had to be recovered.
+static MMKV* openInstance(const Options& options, bool readOnly, size_t* recoveries = nullptr) {
+  std::string encryptionKey = options.encryptionKey;
+  std::string* encryptionKeyPtr = encryptionKey.empty() ? nullptr : &encryptionKey;
+  MMKVMode mode = readOnly ? MMKV_SINGLE_PROCESS | MMKV_READ_ONLY : MMKV_SINGLE_PROCESS;
+  MmkvRecovery::OpeningScope recoveryScope(true);
+  MMKV* mmkv = MMKV::mmkvWithID(options.id, DEFAULT_MMAP_SIZE, mode, encryptionKeyPtr);
+  if (mmkv != nullptr) {
+    MmkvRecovery::setRecoverOnCorruption(mmkv->mmapID(), true);
+  }
+  if (recoveries != nullptr) {
+    *recoveries = recoveryScope.getRecoveryCount();
+  }
+  return mmkv;
+}
+
+static int runStats(MMKV* mmkv) {
+  std::vector<std::string> keys = mmkv->allKeys();
+  size_t keyBytes = 0, valueBytes = 0;
+  for (const std::string& key : keys) {
+    keyBytes += key.size();
+    valueBytes += mmkv->getValueSize(key, false);
+  }
+  size_t actualSize = mmkv->actualSize();
+  size_t liveSize = keyBytes + valueBytes;
+  // Whatever is not a live key or value is overwritten/deleted records (plus length prefixes).
+  double fragmentation =
+      actualSize > 0 ? 1.0 - static_cast<double>(std::min(liveSize, actualSize)) / actualSize : 0;
+
+  std::printf("Instance:       %s\n", mmkv->mmapID().c_str());
+  std::printf("Keys:           %zu\n", keys.size());
+  std::printf("File size:      %zu bytes\n", mmkv->totalSize());
+  std::printf("Used:           %zu bytes\n", actualSize);
+  std::printf("Live keys:      %zu bytes\n", keyBytes);
+  std::printf("Live values:    %zu bytes\n", valueBytes);
+  std::printf("Fragmentation:  %.1f%% (run `compact` to reclaim it)\n", fragmentation * 100);
+  return 0;
+}
+
+static int runDump(MMKV* mmkv, const Options& options, const MmkvKeyCodec& keyCodec) {
+  std::vector<std::string> keys = mmkv->allKeys();
+  std::sort(keys.begin(), keys.end());
+  for (const std::string& key : keys) {
+    if (!MmkvKeyCodec::isReservedKey(key)) {
+      printEntry(keyCodec.decode(key), readValueAsJson(mmkv, key, options.type));
+    }
+  }
+  return 0;
+}
+
+static int runGrep(MMKV* mmkv, const Options& options, const MmkvKeyCodec& keyCodec) {
+  std::regex pattern;
+  try {
+    pattern = std::regex(options.pattern);
+  } catch (const std::regex_error& error) {
+    std::fprintf(stderr, "Invalid pattern \"%s\": %s\n", options.pattern.c_str(), error.what());
+    return 1;
+  }
+
+  std::vector<std::string> keys = mmkv->allKeys();
+  std::sort(keys.begin(), keys.end());
+  size_t matches = 0;
+  for (const std::string& key : keys) {
+    if (MmkvKeyCodec::isReservedKey(key)) {
+      continue;
+    }
+    std::string name = keyCodec.decode(key);
+    bool isMatch = std::regex_search(name, pattern);
+    if (!isMatch && isLengthDelimited(mmkv, key)) {
+      std::string value;
+      isMatch = mmkv->getString(key, value) && std::regex_search(value, pattern);
+    }
+    if (isMatch) {
+      printEntry(name, readValueAsJson(mmkv, key, options.type));
+      matches++;
+    }
+  }
+  return matches > 0 ? 0 : 1;
+}
+
+static int runVerify(const Options& options) {
+  if (!MMKV::isFileValid(options.id)) {
+    std::printf("%s: CRC check failed!\n", options.id.c_str());
+    return 1;
+  }
+  // Recovery also kicks in if a record can't be decoded (e.g. a wrong encryption key).
+  size_t recoveries = 0;
+  MMKV* mmkv = openInstance(options, true, &recoveries);
+  if (mmkv == nullptr) {
+    std::printf("%s: failed to open!\n", options.id.c_str());
+    return 1;
+  }
+  // Checks every value by how it is encoded, like `dump` reads it. writeValueToBuffer() can't be
+  // used for this, because it fails for doubles and negative varints.
+  size_t unreadable = 0;
+  for (const std::string& key : mmkv->allKeys()) {
+    bool hasValue;
+    if (isLengthDelimited(mmkv, key)) {
+      MMBuffer buffer;
+      hasValue = mmkv->getBytes(key, buffer);
+    } else {
+      MmkvNumbers::get(mmkv, key, &hasValue);
+    }
+    if (!hasValue) {
+      unreadable++;
+    }
+  }
+  std::printf("%s: CRC ok, %zu keys, %zu unreadable values%s\n", options.id.c_str(),
+              mmkv->count(), unreadable, recoveries > 0 ? ", needed recovery on open" : "");
+  return unreadable == 0 && recoveries == 0 ? 0 : 1;
+}
+
+static int runCompact(MMKV* mmkv) {
+  size_t totalBefore = mmkv->totalSize(), actualBefore = mmkv->actualSize();
+  // trim() rewrites all live records (dropping overwritten ones) and shrinks the file to fit.
+  mmkv->trim();
+  mmkv->sync(MMKV_SYNC);
+  std::printf("Compacted %s: %zu -> %zu bytes used, %zu -> %zu bytes on disk\n",
+              mmkv->mmapID().c_str(), actualBefore, mmkv->actualSize(), totalBefore,
+              mmkv->totalSize());
+  return 0;
+}
+
+static int runRecrypt(MMKV* mmkv, const Options& options) {
+  if (options.newEncryptionKey.size() > 16) {
+    std::fprintf(stderr, "`--new-key` cannot be longer than 16 bytes!\n");
+    return 1;
+  }
+  if (!mmkv->reKey(options.newEncryptionKey)) {
+    std::fprintf(stderr, "Failed to recrypt %s!\n", mmkv->mmapID().c_str());
+    return 1;
+  }
+  mmkv->sync(MMKV_SYNC);
+  std::printf("Recrypted %s (%s)\n", mmkv->mmapID().c_str(),
+              options.newEncryptionKey.empty() ? "now unencrypted" : "with the new key");
+  return 0;
+}
+
+static int runBench(const Options& options) {
+  auto openStart = std::chrono::steady_clock::now();
+  MMKV* mmkv = openInstance(options, true);
+  auto openDuration = std::chrono::steady_clock::now() - openStart;
+  if (mmkv == nullptr) {
+    std::fprintf(stderr, "Failed to open %s!\n", options.id.c_str());
+    return 1;
+  }
+  std::vector<std::string> keys = mmkv->allKeys();
+  if (keys.empty()) {
+    std::fprintf(stderr, "%s has no keys to look up!\n", options.id.c_str());
+    return 1;
+  }
+
+  std::mt19937 random(42);
+  std::vector<uint8_t> scratch;
+  auto measure = [&](const char* name, auto&& lookup) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < options.iterations; i++) {
+      lookup(keys[random() % keys.size()]);
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::printf("%-20s %8.1f ns/op\n", name,
+                static_cast<double>(duration.count()) / options.iterations);
+  };
+
+  std::printf("Open:                %8.2f ms (%zu keys, %zu bytes)\n",
+              std::chrono::duration<double, std::milli>(openDuration).count(), keys.size(),
+              mmkv->actualSize());
+  measure("containsKey (hit)", [&](const std::string& key) { mmkv->containsKey(key); });
+  measure("containsKey (miss)",
+          [&](const std::string& key) { mmkv->containsKey(key + "\x01missing"); });
+  measure("getValueSize", [&](const std::string& key) { mmkv->getValueSize(key, false); });
+  measure("read value", [&](const std::string& key) {
+    size_t size = mmkv->getValueSize(key, false);
+    if (scratch.size() < size) {
+      scratch.resize(size);
+    }
+    mmkv->writeValueToBuffer(key, scratch.data(), static_cast<int32_t>(size));
+  });
+  return 0;
+}
+
+static bool parseType(const std::string& name, ValueType& type) {
+  if (name == "string") {
+    type = ValueType::String;
+  } else if (name == "number") {
+    type = ValueType::Number;
+  } else if (name == "boolean") {
+    type = ValueType::Boolean;
+  } else if (name == "buffer") {
+    type = ValueType::Buffer;
+  } else if (name == "auto") {
+    type = ValueType::Auto;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+static bool parseCount(const std::string& text, size_t& count) {
+  if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+  try {
+    count = std::max<size_t>(std::stoul(text), 1);
+  } catch (const std::out_of_range&) {
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (argc < 2) {
+    printUsage(argv[0]);
+    return 1;
+  }
+  options.command = argv[1];
+  for (int i = 2; i < argc; i++) {
+    std::string arg = argv[i];
+    if (i + 1 < argc && arg == "--dir") {
+      options.dir = argv[++i];
+    } else if (i + 1 < argc && arg == "--id") {
+      options.id = argv[++i];
+    } else if (i + 1 < argc && arg == "--key") {
+      options.encryptionKey = argv[++i];
+    } else if (i + 1 < argc && arg == "--new-key") {
+      options.newEncryptionKey = argv[++i];
+      options.hasNewEncryptionKey = true;
+    } else if (i + 1 < argc && arg == "--key-prefix") {
+      options.keyPrefixes.push_back(argv[++i]);
+    } else if (i + 1 < argc && arg == "--iterations" &&
+               parseCount(argv[i + 1], options.iterations)) {
+      i++;
+    } else if (i + 1 < argc && arg == "--type" && parseType(argv[i + 1], options.type)) {
+      i++;
+    } else if (options.command == "grep" && options.pattern.empty() && arg.rfind("--", 0) != 0) {
+      options.pattern = arg;
+    } else {
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+  if (options.dir.empty() || options.id.empty() ||
+      (options.command == "grep" && options.pattern.empty()) ||
+      (options.command == "recrypt" && !options.hasNewEncryptionKey)) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  MmkvKeyCodec keyCodec;
+  try {
+    keyCodec = MmkvKeyCodec(options.keyPrefixes);
+  } catch (const std::invalid_argument& error) {
+    std::fprintf(stderr, "%s\n", error.what());
+    return 1;
+  }
+
+  MMKV::initializeMMKV(options.dir, MMKVLogNone);
+  MmkvRecovery::install();
+
+  if (options.command == "verify") {
+    return runVerify(options);
+  }
+  if (options.command == "bench") {
+    return runBench(options);
+  }
+
+  // Only compact and recrypt write to the file.
+  bool isWrite = options.command == "compact" || options.command == "recrypt";
+  MMKV* mmkv = openInstance(options, !isWrite);
+  if (mmkv == nullptr) {
+    std::fprintf(stderr, "Failed to open %s in %s!\n", options.id.c_str(), options.dir.c_str());
+    return 1;
+  }
+
+  int result;
+  if (options.command == "stats") {
+    result = runStats(mmkv);
+  } else if (options.command == "dump") {
+    result = runDump(mmkv, options, keyCodec);
+  } else if (options.command == "grep") {
+    result = runGrep(mmkv, options, keyCodec);
+  } else if (options.command == "compact") {
+    result = runCompact(mmkv);
+  } else if (options.command == "recrypt") {
+    result = runRecrypt(mmkv, options);
+  } else {
+    printUsage(argv[0]);
+    result = 1;
+  }
+  mmkv->close();
+  MMKV::onExit();
+  return result;
+}
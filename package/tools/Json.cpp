@@ -0,0 +1,386 @@
+//
+//  Json.cpp
+//  react-native-mmkv
+//
+
+#include "Json.h"
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+
+class JsonParser {
+public:
+  explicit JsonParser(const std::string& text) : _text(text), _position(0) {}
+
+  JsonValue parseDocument() {
+    JsonValue value = parseValue(0);
+    skipWhitespace();
+    if (_position != _text.size()) {
+      fail("Unexpected trailing characters");
+    }
+    return value;
+  }
+
+private:
+  static constexpr int kMaxDepth = 512;
+
+  [[noreturn]] void fail(const std::string& message) const {
+    throw std::runtime_error(message + " at offset " + std::to_string(_position));
+  }
+
+  void skipWhitespace() {
+    while (_position < _text.size() && (_text[_position] == ' ' || _text[_position] == '\t' ||
+                                        _text[_position] == '\n' || _text[_position] == '\r')) {
+      _position++;
+    }
+  }
+
+  bool consume(const char* literal) {
+    size_t length = std::char_traits<char>::length(literal);
+    if (_text.compare(_position, length, literal) == 0) {
+      _position += length;
+      return true;
+    }
+    return false;
+  }
+
+  JsonValue parseValue(int depth) {
+    if (depth > kMaxDepth) {
+      fail("Document is nested too deeply");
+    }
+    skipWhitespace();
+    if (_position >= _text.size()) {
+      fail("Unexpected end of input");
+    }
+
+    JsonValue value;
+    char c = _text[_position];
+    if (c == '{') {
+      value.type = JsonValue::Type::Object;
+      _position++;
+      skipWhitespace();
+      if (consume("}")) {
+        return value;
+      }
+      while (true) {
+        skipWhitespace();
+        if (_position >= _text.size() || _text[_position] != '"') {
+          fail("Expected an object key");
+        }
+        std::string key = parseString();
+        skipWhitespace();
+        if (!consume(":")) {
+          fail("Expected ':'");
+        }
+        value.object.emplace_back(std::move(key), parseValue(depth + 1));
+        skipWhitespace();
+        if (consume("}")) {
+          return value;
+        }
+        if (!consume(",")) {
+          fail("Expected ',' or '}'");
+        }
+      }
+    }
+    if (c == '[') {
+      value.type = JsonValue::Type::Array;
+      _position++;
+      skipWhitespace();
+      if (consume("]")) {
+        return value;
+      }
+      while (true) {
+        value.array.push_back(parseValue(depth + 1));
+        skipWhitespace();
+        if (consume("]")) {
+          return value;
+        }
+        if (!consume(",")) {
+          fail("Expected ',' or ']'");
+        }
+      }
+    }
+    if (c == '"') {
+      value.type = JsonValue::Type::String;
+      value.string = parseString();
+      return value;
+    }
+    if (consume("true")) {
+      value.type = JsonValue::Type::Boolean;
+      value.boolean = true;
+      return value;
+    }
+    if (consume("false")) {
+      value.type = JsonValue::Type::Boolean;
+      return value;
+    }
+    if (consume("null")) {
+      return value;
+    }
+    value.type = JsonValue::Type::Number;
+    value.number = parseNumber();
+    return value;
+  }
+
+  double parseNumber() {
+    size_t start = _position;
+    while (_position < _text.size() && std::string_view("+-0123456789.eE").find(
+                                           _text[_position]) != std::string_view::npos) {
+      _position++;
+    }
+    double number = 0;
+    auto result = std::from_chars(_text.data() + start, _text.data() + _position, number);
+    if (start == _position || result.ec != std::errc() || result.ptr != _text.data() + _position) {
+      _position = start;
+      fail("Invalid value");
+    }
+    return number;
+  }
+
+  uint32_t parseHex4() {
+    if (_position + 4 > _text.size()) {
+      fail("Invalid unicode escape");
+    }
+    uint32_t codePoint = 0;
+    auto result = std::from_chars(_text.data() + _position, _text.data() + _position + 4,
+                                  codePoint, 16);
+    if (result.ptr != _text.data() + _position + 4) {
+      fail("Invalid unicode escape");
+    }
+    _position += 4;
+    return codePoint;
+  }
+
+  static void appendUtf8(std::string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+      out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+      out += static_cast<char>(0xC0 | (codePoint >> 6));
+      out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+      out += static_cast<char>(0xE0 | (codePoint >> 12));
+      out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+      out += static_cast<char>(0xF0 | (codePoint >> 18));
+      out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+      out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+  }
+
+  std::string parseString() {
+    _position++; // opening quote
+    std::string out;
+    while (true) {
+      if (_position >= _text.size()) {
+        fail("Unterminated string");
+      }
+      char c = _text[_position++];
+      if (c == '"') {
+        return out;
+      }
+      if (static_cast<unsigned char>(c) < 0x20) {
+        fail("Control character in string");
+      }
+      if (c != '\\') {
+        out += c;
+        continue;
+      }
+      if (_position >= _text.size()) {
+        fail("Unterminated string");
+      }
+      char escape = _text[_position++];
+      switch (escape) {
+        case '"':
+        case '\\':
+        case '/':
+          out += escape;
+          break;
+        case 'b':
+          out += '\b';
+          break;
+        case 'f':
+          out += '\f';
+          break;
+        case 'n':
+          out += '\n';
+          break;
+        case 'r':
+          out += '\r';
+          break;
+        case 't':
+          out += '\t';
+          break;
+        case 'u': {
+          uint32_t codePoint = parseHex4();
+          if (codePoint >= 0xD800 && codePoint <= 0xDBFF && consume("\\u")) {
+            uint32_t low = parseHex4();
+            if (low >= 0xDC00 && low <= 0xDFFF) {
+              codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+            } else {
+              appendUtf8(out, 0xFFFD);
+              codePoint = low;
+            }
+          }
+          if (codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+            // Lone surrogates can't be represented in UTF-8.
+            codePoint = 0xFFFD;
+          }
+          appendUtf8(out, codePoint);
+          break;
+        }
+        default:
+          _position--;
+          fail("Invalid escape sequence");
+      }
+    }
+  }
+
+private:
+  const std::string& _text;
+  size_t _position;
+};
+
+} // namespace
+
+JsonValue parseJson(const std::string& text) {
+  return JsonParser(text).parseDocument();
+}
+
+std::string quoteJson(const std::string& text) {
+  std::string out = "\"";
+  for (char c : text) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escape[8];
+          std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned char>(c));
+          out += escape;
+        } else {
+          out += c;
+        }
+    }
+  }
+  return out + "\"";
+}
+
+std::string toJson(const JsonValue& value) {
+  switch (value.type) {
+    case JsonValue::Type::Null:
+      return "null";
+    case JsonValue::Type::Boolean:
+      return value.boolean ? "true" : "false";
+    case JsonValue::Type::Number: {
+      if (!std::isfinite(value.number)) {
+        return "null";
+      }
+      if (value.number == 0) {
+        return "0"; // no "-0"
+      }
+      // Shortest representation that round-trips, like JS does.
+      char buffer[32];
+      auto result = std::to_chars(buffer, buffer + sizeof(buffer), value.number);
+      return std::string(buffer, result.ptr);
+    }
+    case JsonValue::Type::String:
+      return quoteJson(value.string);
+    case JsonValue::Type::Array: {
+      std::string out = "[";
+      for (size_t i = 0; i < value.array.size(); i++) {
+        out += (i > 0 ? "," : "") + toJson(value.array[i]);
+      }
+      return out + "]";
+    }
+    case JsonValue::Type::Object: {
+      std::string out = "{";
+      for (size_t i = 0; i < value.object.size(); i++) {
+        out += (i > 0 ? "," : "") + quoteJson(value.object[i].first) + ":" +
+               toJson(value.object[i].second);
+      }
+      return out + "}";
+    }
+  }
+  return "null";
+}
+
+std::string toBase64(const uint8_t* data, size_t length) {
+  static const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  for (size_t i = 0; i < length; i += 3) {
+    uint32_t chunk = static_cast<uint32_t>(data[i]) << 16;
+    if (i + 1 < length) {
+      chunk |= static_cast<uint32_t>(data[i + 1]) << 8;
+    }
+    if (i + 2 < length) {
+      chunk |= data[i + 2];
+    }
+    out += alphabet[(chunk >> 18) & 0x3F];
+    out += alphabet[(chunk >> 12) & 0x3F];
+    out += i + 1 < length ? alphabet[(chunk >> 6) & 0x3F] : '=';
+    out += i + 2 < length ? alphabet[chunk & 0x3F] : '=';
+  }
+  return out;
+}
+
+std::string fromBase64(const std::string& text) {
+  auto decodeChar = [](char c) -> int {
+    if (c >= 'A' && c <= 'Z') {
+      return c - 'A';
+    } else if (c >= 'a' && c <= 'z') {
+      return c - 'a' + 26;
+    } else if (c >= '0' && c <= '9') {
+      return c - '0' + 52;
+    } else if (c == '+') {
+      return 62;
+    } else if (c == '/') {
+      return 63;
+    }
+    return -1;
+  };
+
+  if (text.size() % 4 != 0) {
+    throw std::runtime_error("Invalid base64: length is not a multiple of 4");
+  }
+  std::string out;
+  out.reserve(text.size() / 4 * 3);
+  for (size_t i = 0; i < text.size(); i += 4) {
+    bool isLast = i + 4 == text.size();
+    size_t padding = isLast ? (text[i + 3] == '=') + (text[i + 2] == '=') : 0;
+    uint32_t chunk = 0;
+    for (size_t j = 0; j < 4; j++) {
+      int bits = j < 4 - padding ? decodeChar(text[i + j]) : 0;
+      if (bits < 0) {
+        throw std::runtime_error("Invalid base64: unexpected character at " +
+                                 std::to_string(i + j));
+      }
+      chunk = (chunk << 6) | static_cast<uint32_t>(bits);
+    }
+    out += static_cast<char>((chunk >> 16) & 0xFF);
+    if (padding < 2) {
+      out += static_cast<char>((chunk >> 8) & 0xFF);
+    }
+    if (padding < 1) {
+      out += static_cast<char>(chunk & 0xFF);
+    }
+  }
+  return out;
+}
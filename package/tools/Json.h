@@ -0,0 +1,52 @@
+//
+//  Json.h
+//  react-native-mmkv
+//
+//  A minimal JSON reader/writer for the host tools - just enough to read seed data and print
+//  entries, without pulling in a dependency.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct JsonValue {
+  enum class Type { Null, Boolean, Number, String, Array, Object };
+
+  Type type = Type::Null;
+  bool boolean = false;
+  double number = 0;
+  std::string string;
+  std::vector<JsonValue> array;
+  // Members in document order - duplicate keys are kept, the last one wins when applied.
+  std::vector<std::pair<std::string, JsonValue>> object;
+};
+
+/**
+ Parses a single JSON document. Throws a std::runtime_error (with the byte offset) if it is invalid.
+ */
+JsonValue parseJson(const std::string& text);
+
+/**
+ Serializes the value the way `JSON.stringify` would (without whitespace).
+ */
+std::string toJson(const JsonValue& value);
+
+/**
+ Quotes and escapes the given UTF-8 string as a JSON string literal.
+ */
+std::string quoteJson(const std::string& text);
+
+/**
+ Encodes binary data as (padded) base64, for `{"$base64": "..."}` values.
+ */
+std::string toBase64(const uint8_t* data, size_t length);
+
+/**
+ Decodes (padded) base64. Throws a std::runtime_error if it is invalid.
+ */
+std::string fromBase64(const std::string& text);
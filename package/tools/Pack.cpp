@@ -0,0 +1,233 @@
+//
+//  Pack.cpp
+//  react-native-mmkv
+//
+//  Builds a compacted MMKV file from JSON or NDJSON seed data, so apps can ship prebuilt instances
+//  (e.g. as an `overlayBasePath` base file) instead of writing thousands of keys on first launch.
+//
+//  Usage: mmkv-pack --input <file|-> --dir <path> --id <id> [--key <encryptionKey>] [--ndjson]
+//                   [--key-prefix <prefix>]... [--compact-numbers]
+//
+
+#include "Json.h"
+#include "MMKV.h"
+#include "MmkvKeyCodec.h"
+#include "MmkvNumbers.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+using namespace mmkv;
+
+struct Options {
+  std::string input = "-";
+  std::string dir;
+  std::string id;
+  std::string encryptionKey;
+  bool ndjson = false;
+  bool compactNumbers = false;
+  std::vector<std::string> keyPrefixes;
+};
+
+static void printUsage(const char* program) {
+  std::fprintf(stderr,
+               "Usage: %s --input <file|-> --dir <path> --id <id> [--key <encryptionKey>] "
+               "[--ndjson] [--key-prefix <prefix>]... [--compact-numbers]\n\n"
+               "JSON input is a single object of key/value pairs, NDJSON input is one such object "
+               "per line.\nStrings, numbers and booleans are stored as-is, objects and arrays as "
+               "JSON strings\n(like `JSON.stringify`), `{\"$base64\": \"...\"}` objects as "
+               "buffers, and `null` values are skipped.\n"
+               "Pass the instance's `keyPrefixes` (in order) as --key-prefix to store keys "
+               "front-coded.\n"
+               "Pass --compact-numbers if the instance uses `compactNumbers`.\n",
+               program);
+}
+
+static std::string readInput(const std::string& input) {
+  std::ostringstream contents;
+  if (input == "-") {
+    contents << std::cin.rdbuf();
+  } else {
+    std::ifstream file(input, std::ios::binary);
+    if (!file) {
+      throw std::runtime_error("Failed to open " + input + "!");
+    }
+    contents << file.rdbuf();
+  }
+  return contents.str();
+}
+
+// `{"$base64": "..."}` is a buffer, as printed by `mmkv-inspect dump`.
+static bool isBase64Value(const JsonValue& value) {
+  return value.type == JsonValue::Type::Object && value.object.size() == 1 &&
+         value.object[0].first == "$base64" &&
+         value.object[0].second.type == JsonValue::Type::String;
+}
+
+static void collectEntries(const JsonValue& document, std::map<std::string, JsonValue>& entries) {
+  if (document.type != JsonValue::Type::Object) {
+    throw std::runtime_error("Expected a JSON object of key/value pairs!");
+  }
+  for (const auto& [key, value] : document.object) {
+    if (key.empty()) {
+      throw std::runtime_error("Keys cannot be empty!");
+    }
+    if (isBase64Value(value)) {
+      try {
+        fromBase64(value.object[0].second.string);
+      } catch (const std::runtime_error& error) {
+        throw std::runtime_error("\"" + key + "\": " + error.what());
+      }
+    }
+    entries[key] = value;
+  }
+}
+
+static bool setValue(MMKV* mmkv, const std::string& key, const JsonValue& value,
+                     bool compactNumbers) {
+  switch (value.type) {
+    case JsonValue::Type::Null:
+      return true;
+    case JsonValue::Type::Boolean:
+      return mmkv->set(value.boolean, key);
+    case JsonValue::Type::Number:
+      return MmkvNumbers::set(mmkv, value.number, key, compactNumbers);
+    case JsonValue::Type::String:
+      return mmkv->set(value.string, key);
+    case JsonValue::Type::Object:
+      if (isBase64Value(value)) {
+        std::string bytes = fromBase64(value.object[0].second.string);
+        MMBuffer buffer(bytes.data(), bytes.size(), MMBufferNoCopy);
+        return mmkv->set(buffer, key);
+      }
+      return mmkv->set(toJson(value), key);
+    case JsonValue::Type::Array:
+      return mmkv->set(toJson(value), key);
+  }
+  return false;
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--ndjson") {
+      options.ndjson = true;
+    } else if (arg == "--compact-numbers") {
+      options.compactNumbers = true;
+    } else if (i + 1 < argc && arg == "--input") {
+      options.input = argv[++i];
+    } else if (i + 1 < argc && arg == "--dir") {
+      options.dir = argv[++i];
+    } else if (i + 1 < argc && arg == "--id") {
+      options.id = argv[++i];
+    } else if (i + 1 < argc && arg == "--key") {
+      options.encryptionKey = argv[++i];
+    } else if (i + 1 < argc && arg == "--key-prefix") {
+      options.keyPrefixes.push_back(argv[++i]);
+    } else {
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+  if (options.dir.empty() || options.id.empty()) {
+    printUsage(argv[0]);
+    return 1;
+  }
+  if (options.encryptionKey.size() > 16) {
+    std::fprintf(stderr, "`--key` cannot be longer than 16 bytes!\n");
+    return 1;
+  }
+  std::string extension = options.input.substr(options.input.find_last_of('.') + 1);
+  options.ndjson = options.ndjson || extension == "ndjson" || extension == "jsonl";
+
+  MmkvKeyCodec keyCodec;
+  try {
+    keyCodec = MmkvKeyCodec(options.keyPrefixes);
+  } catch (const std::invalid_argument& error) {
+    std::fprintf(stderr, "%s\n", error.what());
+    return 1;
+  }
+
+  // 1. Parse everything first, so invalid input never leaves a half-written file behind.
+  std::map<std::string, JsonValue> entries;
+  try {
+    std::string contents = readInput(options.input);
+    if (options.ndjson) {
+      std::istringstream lines(contents);
+      std::string line;
+      size_t lineNumber = 0;
+      while (std::getline(lines, line)) {
+        lineNumber++;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+          continue;
+        }
+        try {
+          collectEntries(parseJson(line), entries);
+        } catch (const std::runtime_error& error) {
+          throw std::runtime_error("Line " + std::to_string(lineNumber) + ": " + error.what());
+        }
+      }
+    } else {
+      collectEntries(parseJson(contents), entries);
+    }
+  } catch (const std::runtime_error& error) {
+    std::fprintf(stderr, "Invalid input: %s\n", error.what());
+    return 1;
+  }
+
+  // 2. Write all entries into an empty instance. Sorted keys and a single write per key mean the
+  //    file contains no overwritten records, so there is nothing left for MMKV to compact later.
+  mkdir(options.dir.c_str(), 0755);
+  MMKV::initializeMMKV(options.dir, MMKVLogNone);
+  std::string* encryptionKeyPtr = options.encryptionKey.empty() ? nullptr : &options.encryptionKey;
+  MMKV* mmkv =
+      MMKV::mmkvWithID(options.id, DEFAULT_MMAP_SIZE, MMKV_SINGLE_PROCESS, encryptionKeyPtr);
+  if (mmkv == nullptr) {
+    std::fprintf(stderr, "Failed to open MMKV instance \"%s\" in %s!\n", options.id.c_str(),
+                 options.dir.c_str());
+    return 1;
+  }
+  mmkv->clearAll();
+
+  size_t written = 0, skipped = 0;
+  for (const auto& [key, value] : entries) {
+    if (value.type == JsonValue::Type::Null) {
+      skipped++;
+      continue;
+    }
+    std::string storedKey;
+    try {
+      storedKey = keyCodec.encode(key);
+    } catch (const std::invalid_argument& error) {
+      std::fprintf(stderr, "Invalid key \"%s\": %s\n", key.c_str(), error.what());
+      return 1;
+    }
+    if (!setValue(mmkv, storedKey, value, options.compactNumbers)) {
+      std::fprintf(stderr, "Failed to write \"%s\"!\n", key.c_str());
+      return 1;
+    }
+    written++;
+  }
+
+  // Keys are already encoded, so only the prefix list is recorded for the runtime.
+  keyCodec.writeSignature(mmkv);
+
+  // 3. Shrink the file down to what the entries need.
+  mmkv->trim();
+  mmkv->sync(MMKV_SYNC);
+  std::printf("Packed %zu keys (%zu null values skipped) into %s/%s: %zu bytes used, %zu bytes "
+              "on disk%s\n",
+              written, skipped, options.dir.c_str(), options.id.c_str(), mmkv->actualSize(),
+              mmkv->totalSize(), encryptionKeyPtr != nullptr ? " (encrypted)" : "");
+  mmkv->close();
+  MMKV::onExit();
+  return 0;
+}
@@ -0,0 +1,35 @@
+//
+//  MmkvArgumentsTest.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvArguments.h"
+#include <gtest/gtest.h>
+#include <limits>
+
+using MmkvArguments::isIntegerInRange;
+
+TEST(MmkvArguments, AcceptsIntegersInRange) {
+  EXPECT_TRUE(isIntegerInRange(0, 0, 10));
+  EXPECT_TRUE(isIntegerInRange(10, 0, 10));
+  EXPECT_TRUE(isIntegerInRange(MmkvArguments::kMaxSafeInteger, 0, MmkvArguments::kMaxSafeInteger));
+}
+
+TEST(MmkvArguments, RejectsValuesOutOfRange) {
+  EXPECT_FALSE(isIntegerInRange(-1, 0, 10));
+  EXPECT_FALSE(isIntegerInRange(11, 0, 10));
+  EXPECT_FALSE(isIntegerInRange(0, 1, MmkvArguments::kMaxInt32));
+  EXPECT_FALSE(isIntegerInRange(MmkvArguments::kMaxInt32 + 1, 1, MmkvArguments::kMaxInt32));
+}
+
+TEST(MmkvArguments, RejectsFractions) {
+  EXPECT_FALSE(isIntegerInRange(0.5, 0, 10));
+  EXPECT_FALSE(isIntegerInRange(1e-300, 0, 10));
+}
+
+TEST(MmkvArguments, RejectsNaNAndInfinity) {
+  double max = std::numeric_limits<double>::max();
+  EXPECT_FALSE(isIntegerInRange(std::numeric_limits<double>::quiet_NaN(), 0, max));
+  EXPECT_FALSE(isIntegerInRange(std::numeric_limits<double>::infinity(), 0, max));
+  EXPECT_FALSE(isIntegerInRange(-std::numeric_limits<double>::infinity(), -max, 0));
+}
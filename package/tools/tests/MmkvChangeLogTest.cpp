@@ -0,0 +1,105 @@
+//
+//  MmkvChangeLogTest.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvChangeLog.h"
+#include "TestInstance.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+class MmkvChangeLogTest : public testing::Test {
+protected:
+  void SetUp() override {
+    _storage = openTestInstance("changelog");
+  }
+
+  // All keys after `sequence`, in pages of `limit`.
+  static std::vector<std::string> getKeysSince(MmkvChangeLog& log, int64_t sequence,
+                                               size_t limit = 100) {
+    std::vector<std::string> keys;
+    bool hasMore = true;
+    while (hasMore) {
+      for (const MmkvChangeLog::Change& change :
+           log.getChangesSince(sequence, limit, sequence, hasMore)) {
+        keys.push_back(change.isDeleted ? "-" + change.key : change.key);
+      }
+    }
+    return keys;
+  }
+
+  MMKV* _storage;
+};
+
+TEST_F(MmkvChangeLogTest, ReturnsEachKeyOnceWithItsLatestChange) {
+  MmkvChangeLog log(_storage);
+  { auto change = log.recordWrite("a"); }
+  { auto change = log.recordWrite("b"); }
+  { auto change = log.recordWrite("a"); }
+  { auto change = log.recordDelete("b"); }
+
+  EXPECT_EQ(log.getSequence(), 4);
+  EXPECT_EQ(getKeysSince(log, 0), (std::vector<std::string>{"a", "-b"}));
+  EXPECT_EQ(getKeysSince(log, 0, 1), (std::vector<std::string>{"a", "-b"}));
+  EXPECT_EQ(getKeysSince(log, 3), (std::vector<std::string>{"-b"}));
+}
+
+TEST_F(MmkvChangeLogTest, HidesChangesThatAreStillBeingMade) {
+  MmkvChangeLog log(_storage);
+  { auto change = log.recordWrite("a"); }
+  {
+    auto pending = log.recordWrite("b");
+    { auto change = log.recordWrite("c"); }
+    EXPECT_EQ(log.getSequence(), 1);
+    EXPECT_EQ(getKeysSince(log, 0), (std::vector<std::string>{"a"}));
+  }
+  EXPECT_EQ(log.getSequence(), 3);
+  EXPECT_EQ(getKeysSince(log, 1), (std::vector<std::string>{"b", "c"}));
+}
+
+TEST_F(MmkvChangeLogTest, IsRestoredWhenReopened) {
+  {
+    MmkvChangeLog log(_storage);
+    { auto change = log.recordWrite("a"); }
+    { auto change = log.recordDeletes({"b", "c"}); }
+  }
+  MmkvChangeLog log(_storage);
+  EXPECT_EQ(log.getSequence(), 3);
+  EXPECT_EQ(getKeysSince(log, 0), (std::vector<std::string>{"a", "-b", "-c"}));
+}
+
+TEST_F(MmkvChangeLogTest, TruncatesChangesUpToASequence) {
+  MmkvChangeLog log(_storage);
+  for (const char* key : {"a", "b", "c", "d"}) {
+    auto change = log.recordWrite(key);
+  }
+
+  EXPECT_EQ(log.truncateBefore(2), 2u);
+  EXPECT_EQ(getKeysSince(log, 0), (std::vector<std::string>{"c", "d"}));
+  EXPECT_EQ(_storage->count(), 2u);
+  EXPECT_EQ(log.truncateBefore(2), 0u);
+}
+
+TEST_F(MmkvChangeLogTest, KeepsTheLatestChangeWhenTruncating) {
+  {
+    MmkvChangeLog log(_storage);
+    { auto change = log.recordWrite("a"); }
+    { auto change = log.recordDelete("b"); }
+    EXPECT_EQ(log.truncateBefore(1000), 1u);
+    EXPECT_EQ(getKeysSince(log, 0), (std::vector<std::string>{"-b"}));
+  }
+  // The sequence number must not go back, or readers would skip the next changes.
+  MmkvChangeLog log(_storage);
+  EXPECT_EQ(log.getSequence(), 2);
+}
+
+TEST_F(MmkvChangeLogTest, DoesNotTruncateChangesThatAreStillBeingMade) {
+  MmkvChangeLog log(_storage);
+  { auto change = log.recordWrite("a"); }
+  auto pending = log.recordWrite("b");
+  { auto change = log.recordWrite("c"); }
+
+  EXPECT_EQ(log.truncateBefore(3), 1u);
+  EXPECT_EQ(_storage->count(), 2u);
+}
@@ -0,0 +1,90 @@
+//
+//  MmkvDiffTest.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvDiff.h"
+#include "TestInstance.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <limits>
+#include <string>
+#include <vector>
+
+class MmkvDiffTest : public testing::Test {
+protected:
+  void SetUp() override {
+    _a = openTestInstance("diff-a");
+    _b = openTestInstance("diff-b");
+  }
+
+  static MmkvDiff::Side getSide(MMKV* mmkv) {
+    MmkvDiff::Side side;
+    for (const std::string& key : mmkv->allKeys()) {
+      side.keys.emplace(key, key);
+    }
+    side.getInstance = [mmkv](const std::string&) { return mmkv; };
+    return side;
+  }
+
+  MmkvDiff::Result diff() {
+    return MmkvDiff::compute(getSide(_a), getSide(_b));
+  }
+
+  MMKV* _a;
+  MMKV* _b;
+};
+
+using Keys = std::vector<std::string>;
+
+TEST_F(MmkvDiffTest, FindsAddedRemovedAndChangedKeys) {
+  _a->set(std::string("same"), "string");
+  _b->set(std::string("same"), "string");
+  _a->set(std::string("before"), "changed");
+  _b->set(std::string("after!"), "changed");
+  _a->set(true, "removed");
+  _b->set(true, "added");
+
+  MmkvDiff::Result result = diff();
+  EXPECT_EQ(result.added, Keys{"added"});
+  EXPECT_EQ(result.removed, Keys{"removed"});
+  EXPECT_EQ(result.changed, Keys{"changed"});
+}
+
+TEST_F(MmkvDiffTest, ComparesDoubles) {
+  // Doubles used to be compared by copying them as length-delimited values, which only worked if
+  // their first byte happened to look like a length.
+  _a->set(0.1, "same");
+  _b->set(0.1, "same");
+  _a->set(19.99, "changed");
+  _b->set(19.98, "changed");
+  _a->set(0.0, "zero");
+  _b->set(-0.0, "zero");
+
+  EXPECT_EQ(diff().changed, (Keys{"changed", "zero"}));
+}
+
+TEST_F(MmkvDiffTest, ComparesIntegersOfAnyWidth) {
+  _a->set(static_cast<int64_t>(-1), "negative");
+  _b->set(static_cast<int64_t>(-1), "negative");
+  _a->set(std::numeric_limits<int64_t>::min(), "min");
+  _b->set(std::numeric_limits<int64_t>::min(), "min");
+  _a->set(static_cast<int32_t>(-7), "int32");
+  _b->set(static_cast<int32_t>(-7), "int32");
+  _a->set(true, "bool");
+  _b->set(true, "bool");
+  _a->set(static_cast<int64_t>(-2), "changed");
+  _b->set(static_cast<int64_t>(-3), "changed");
+
+  EXPECT_EQ(diff().changed, Keys{"changed"});
+}
+
+TEST_F(MmkvDiffTest, ComparesByStoredBytes) {
+  // A double and an integer with the same value are stored differently.
+  _a->set(1.0, "number");
+  _b->set(static_cast<int64_t>(1), "number");
+  _a->set(std::string(""), "empty");
+  _b->set(std::string(""), "empty");
+
+  EXPECT_EQ(diff().changed, Keys{"number"});
+}
@@ -0,0 +1,93 @@
+//
+//  MmkvNumbersTest.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvNumbers.h"
+#include "TestInstance.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+
+using MmkvNumbers::Encoding;
+using MmkvNumbers::getEncoding;
+
+class MmkvNumbersTest : public testing::Test {
+protected:
+  void SetUp() override {
+    _mmkv = openTestInstance("numbers");
+  }
+
+  MMKV* _mmkv;
+};
+
+TEST_F(MmkvNumbersTest, ReadsDoubles) {
+  for (double value : {0.1, -1.0, 19.99, 1e300}) {
+    _mmkv->set(value, "key");
+    bool hasValue;
+    EXPECT_EQ(getEncoding(_mmkv, "key"), Encoding::Double) << value;
+    EXPECT_EQ(MmkvNumbers::get(_mmkv, "key", &hasValue), value);
+    EXPECT_TRUE(hasValue);
+  }
+}
+
+TEST_F(MmkvNumbersTest, ReadsDoublesThatLookLikeASevenByteString) {
+  // The lowest byte of this double is 7, just like the length prefix of a 7-byte string.
+  uint64_t bits = 0x3FF0000000000007ull;
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  _mmkv->set(value, "key");
+
+  bool hasValue;
+  EXPECT_EQ(getEncoding(_mmkv, "key"), Encoding::Double);
+  EXPECT_EQ(MmkvNumbers::get(_mmkv, "key", &hasValue), value);
+  EXPECT_TRUE(hasValue);
+}
+
+TEST_F(MmkvNumbersTest, ReadsVarints) {
+  _mmkv->set(static_cast<int64_t>(42), "positive");
+  _mmkv->set(static_cast<int64_t>(-1), "negative");
+  _mmkv->set(true, "boolean");
+  _mmkv->set(static_cast<int32_t>(7), "int32");
+
+  for (const char* key : {"positive", "negative", "boolean", "int32"}) {
+    EXPECT_EQ(getEncoding(_mmkv, key), Encoding::Varint) << key;
+  }
+  bool hasValue;
+  EXPECT_EQ(MmkvNumbers::getBigInt(_mmkv, "negative", &hasValue), -1);
+  EXPECT_TRUE(hasValue);
+}
+
+TEST_F(MmkvNumbersTest, ReadsBigInts) {
+  ASSERT_TRUE(MmkvNumbers::setBigInt(_mmkv, INT64_MIN, "key"));
+
+  bool hasValue;
+  EXPECT_EQ(getEncoding(_mmkv, "key"), Encoding::BigInt);
+  EXPECT_EQ(MmkvNumbers::getBigInt(_mmkv, "key", &hasValue), INT64_MIN);
+  EXPECT_TRUE(hasValue);
+}
+
+TEST_F(MmkvNumbersTest, DoesNotReadStringsAsNumbers) {
+  // 7- and 8-byte strings are read as a double and a BigInt (see MmkvNumbers.h).
+  for (std::string text : {"a", "123456", "123456789", "a longer string than any number"}) {
+    _mmkv->set(text, "key");
+    bool hasValue;
+    EXPECT_EQ(getEncoding(_mmkv, "key"), Encoding::None) << text;
+    MmkvNumbers::get(_mmkv, "key", &hasValue);
+    EXPECT_FALSE(hasValue);
+  }
+}
+
+TEST_F(MmkvNumbersTest, ReadsAnEmptyStringAsZero) {
+  _mmkv->set(std::string(), "key");
+  bool hasValue;
+  EXPECT_EQ(MmkvNumbers::get(_mmkv, "key", &hasValue), 0);
+  EXPECT_TRUE(hasValue);
+}
+
+TEST_F(MmkvNumbersTest, DoesNotReadMissingKeys) {
+  bool hasValue;
+  EXPECT_EQ(getEncoding(_mmkv, "missing"), Encoding::None);
+  MmkvNumbers::get(_mmkv, "missing", &hasValue);
+  EXPECT_FALSE(hasValue);
+}
@@ -0,0 +1,109 @@
+//
+//  MmkvRawValueTest.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvRawValue.h"
+#include "TestInstance.h"
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <limits>
+#include <string>
+
+using MmkvRawValue::Encoding;
+using MmkvRawValue::getEncoding;
+
+class MmkvRawValueTest : public testing::Test {
+protected:
+  void SetUp() override {
+    _from = openTestInstance("raw-from");
+    _to = openTestInstance("raw-to");
+  }
+
+  // Copies "key" and checks that the copy is stored with the same encoding and bytes.
+  void expectCopiedExactly() {
+    size_t size = MmkvRawValue::copy(_from, "key", _to, "key");
+    EXPECT_EQ(size, _from->getValueSize("key", false));
+    EXPECT_EQ(_to->getValueSize("key", false), size);
+    EXPECT_EQ(getEncoding(_to, "key"), getEncoding(_from, "key"));
+    EXPECT_TRUE(MmkvRawValue::equals(_from, "key", _to, "key"));
+  }
+
+  MMKV* _from;
+  MMKV* _to;
+};
+
+TEST_F(MmkvRawValueTest, CopiesStringsAndBuffers) {
+  for (const std::string& value : {std::string(""), std::string("1234567"),
+                                   std::string("12345678"), std::string(1000, 'x')}) {
+    _from->set(value, "key");
+    EXPECT_EQ(getEncoding(_from, "key"), Encoding::LengthDelimited);
+    expectCopiedExactly();
+    std::string copied;
+    EXPECT_TRUE(_to->getString("key", copied));
+    EXPECT_EQ(copied, value);
+  }
+}
+
+TEST_F(MmkvRawValueTest, CopiesIntegersWithTheirWidth) {
+  _from->set(true, "key");
+  EXPECT_EQ(getEncoding(_from, "key"), Encoding::Varint);
+  expectCopiedExactly();
+  EXPECT_TRUE(_to->getBool("key"));
+
+  _from->set(static_cast<int32_t>(-7), "key");
+  expectCopiedExactly();
+  EXPECT_EQ(_to->getInt32("key"), -7);
+
+  // Stored in 8 bytes, just like a double.
+  int64_t eightBytes = int64_t(1) << 49;
+  _from->set(eightBytes, "key");
+  expectCopiedExactly();
+  EXPECT_EQ(_to->getInt64("key"), eightBytes);
+
+  _from->set(std::numeric_limits<uint64_t>::max(), "key");
+  expectCopiedExactly();
+  EXPECT_EQ(_to->getUInt64("key"), std::numeric_limits<uint64_t>::max());
+}
+
+TEST_F(MmkvRawValueTest, CopiesDoublesAndFloats) {
+  for (double value : {-1.0, 19.99, 1e300}) {
+    _from->set(value, "key");
+    EXPECT_EQ(getEncoding(_from, "key"), Encoding::Fixed64) << value;
+    expectCopiedExactly();
+    EXPECT_EQ(_to->getDouble("key"), value);
+  }
+
+  _from->set(1.5f, "key");
+  EXPECT_EQ(getEncoding(_from, "key"), Encoding::Fixed32);
+  expectCopiedExactly();
+  EXPECT_EQ(_to->getFloat("key"), 1.5f);
+}
+
+TEST_F(MmkvRawValueTest, CopiesDoublesThatLookLikeAVarint) {
+  // 0.1 is stored as 9A 99 99 99 99 99 B9 3F, which is also an 8-byte varint - copying it as one
+  // still writes the same bytes.
+  _from->set(0.1, "key");
+  EXPECT_EQ(getEncoding(_from, "key"), Encoding::Varint);
+  expectCopiedExactly();
+  EXPECT_EQ(_to->getDouble("key"), 0.1);
+}
+
+TEST_F(MmkvRawValueTest, CopiesDoublesThatLookLikeAString) {
+  // The lowest byte of this double is 7, just like the length prefix of a 7-byte string - copying
+  // it as one still writes the same bytes.
+  uint64_t bits = 0x3FF0000000000007ull;
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  _from->set(value, "key");
+  EXPECT_EQ(getEncoding(_from, "key"), Encoding::LengthDelimited);
+  expectCopiedExactly();
+  EXPECT_EQ(_to->getDouble("key"), value);
+}
+
+TEST_F(MmkvRawValueTest, RemovesTheTargetIfTheSourceIsMissing) {
+  _to->set(std::string("stale"), "key");
+  EXPECT_EQ(MmkvRawValue::copy(_from, "key", _to, "key"), 0u);
+  EXPECT_FALSE(_to->containsKey("key"));
+}
@@ -0,0 +1,101 @@
+//
+//  MmkvRingBufferFileTest.cpp
+//  react-native-mmkv
+//
+
+#include "MmkvRingBufferFile.h"
+#include <cstdlib>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+class MmkvRingBufferFileTest : public testing::Test {
+protected:
+  void SetUp() override {
+    char directory[] = "/tmp/rnmmkv-ring-XXXXXX";
+    ASSERT_NE(mkdtemp(directory), nullptr);
+    _path = std::string(directory) + "/samples";
+    _directory = directory;
+  }
+  void TearDown() override {
+    unlink(_path.c_str());
+    rmdir(_directory.c_str());
+  }
+
+  std::vector<double> last(const MmkvRingBufferFile& file, size_t count) {
+    std::vector<double> samples(count);
+    samples.resize(file.copyLast(count, samples.data()));
+    return samples;
+  }
+
+  off_t fileSize() {
+    struct stat fileStat;
+    return stat(_path.c_str(), &fileStat) == 0 ? fileStat.st_size : -1;
+  }
+
+  std::string _directory;
+  std::string _path;
+};
+
+TEST_F(MmkvRingBufferFileTest, KeepsTheLastCapacitySamples) {
+  MmkvRingBufferFile file(_path, 3);
+  for (double sample : {1.0, 2.0, 3.0, 4.0}) {
+    file.push(sample);
+  }
+
+  EXPECT_EQ(file.size(), 3u);
+  EXPECT_EQ(last(file, 10), (std::vector<double>{2, 3, 4}));
+  EXPECT_EQ(last(file, 2), (std::vector<double>{3, 4}));
+  EXPECT_EQ(last(file, 0), std::vector<double>{});
+}
+
+TEST_F(MmkvRingBufferFileTest, KeepsSamplesWhenReopened) {
+  {
+    MmkvRingBufferFile file(_path, 4);
+    file.push(60);
+    file.push(59);
+  }
+  MmkvRingBufferFile file(_path, 4);
+  EXPECT_EQ(last(file, 4), (std::vector<double>{60, 59}));
+}
+
+TEST_F(MmkvRingBufferFileTest, SharesSamplesBetweenMappingsOfTheSameFile) {
+  MmkvRingBufferFile first(_path, 4);
+  MmkvRingBufferFile second(_path, 4);
+  first.push(1);
+  EXPECT_EQ(last(second, 4), (std::vector<double>{1}));
+}
+
+TEST_F(MmkvRingBufferFileTest, RefusesADifferentCapacityWithoutTouchingTheFile) {
+  MmkvRingBufferFile file(_path, 4);
+  file.push(1);
+  off_t size = fileSize();
+
+  EXPECT_THROW(MmkvRingBufferFile(_path, 2), std::runtime_error);
+  EXPECT_EQ(fileSize(), size);
+  // The existing mapping is still intact.
+  file.push(2);
+  EXPECT_EQ(last(file, 4), (std::vector<double>{1, 2}));
+}
+
+TEST_F(MmkvRingBufferFileTest, RefusesATruncatedFile) {
+  { MmkvRingBufferFile file(_path, 4); }
+  ASSERT_EQ(truncate(_path.c_str(), fileSize() - 8), 0);
+  EXPECT_THROW(MmkvRingBufferFile(_path, 4), std::runtime_error);
+}
+
+TEST_F(MmkvRingBufferFileTest, InitializesAFileWithoutAValidHeader) {
+  int fd = open(_path.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(write(fd, "garbage", 7), 7);
+  close(fd);
+
+  MmkvRingBufferFile file(_path, 2);
+  EXPECT_EQ(file.size(), 0u);
+  // A 24-byte header, followed by the samples
+  EXPECT_EQ(fileSize(), static_cast<off_t>(24 + 2 * sizeof(double)));
+}
@@ -0,0 +1,30 @@
+//
+//  TestInstance.h
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKV.h"
+#include <cstdlib>
+#include <string>
+
+/**
+ Opens the MMKV instance with the given ID for a test, and clears it.
+ All tests share one temporary root directory, because MMKV is initialized once per process.
+ */
+inline MMKV* openTestInstance(const std::string& id) {
+  static const bool isInitialized = [] {
+    char directory[] = "/tmp/rnmmkv-tests-XXXXXX";
+    if (mkdtemp(directory) == nullptr) {
+      std::abort();
+    }
+    MMKV::initializeMMKV(directory, MMKVLogNone);
+    return true;
+  }();
+  (void)isInitialized;
+
+  MMKV* mmkv = MMKV::mmkvWithID(id, DEFAULT_MMAP_SIZE, MMKV_SINGLE_PROCESS);
+  mmkv->clearAll();
+  return mmkv;
+}